@@ -0,0 +1,71 @@
+#include "bets.h"
+
+//remove all bets from the slip
+void bet_slip_clear(BetSlip *slip) {
+    slip->count = 0;
+}
+
+//add a bet to the slip, returns false if the slip is already full
+bool bet_slip_add(BetSlip *slip, uint8_t bet_id, uint32_t amount) {
+    if (bet_slip_full(slip)) {
+        return false;
+    }
+    Bet *bet = &slip->bets[slip->count++];
+    bet->bet_id = bet_id;
+    bet->amount = amount;
+    return true;
+}
+
+//check if another bet can be placed
+bool bet_slip_full(const BetSlip *slip) {
+    return slip->count >= BET_SLIP_SIZE;
+}
+
+//total money staked across the slip
+uint32_t bet_slip_total(const BetSlip *slip) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < slip->count; i++) {
+        total += slip->bets[i].amount;
+    }
+    return total;
+}
+
+//all pockets covered by at least one bet on the slip
+PocketMask bet_slip_pockets(const BetSlip *slip) {
+    PocketMask pockets = 0;
+    for (uint8_t i = 0; i < slip->count; i++) {
+        pockets |= bet_pockets[slip->bets[i].bet_id];
+    }
+    return pockets;
+}
+
+//total returned to the player (stakes included) when the given pocket wins
+uint32_t bet_slip_resolve(const BetSlip *slip, uint8_t pocket) {
+    uint32_t winnings = 0;
+    for (uint8_t i = 0; i < slip->count; i++) {
+        winnings += slip->bets[i].amount * payout_matrix[slip->bets[i].bet_id][pocket];
+    }
+    return winnings;
+}
+
+//parse a typed bet name, any prefix that only one bet type starts with is completed
+BetType parse_bet_type(const char *input) {
+    uint8_t node = 0; //start at the root
+    //follow the trie one character at a time
+    while (*input != '\0') {
+        uint8_t child = bet_type_trie[node].first_child;
+        while (child != 0 && bet_type_trie[child].c != *input) {
+            child = bet_type_trie[child].next_sibling;
+        }
+        if (child == 0) {
+            return BET_TYPE_NONE; //no bet type starts with the input
+        }
+        node = child;
+        input++;
+    }
+    //prefer an exact match, otherwise the unique completion (if any)
+    if (bet_type_trie[node].bet_type != BET_TYPE_NONE) {
+        return bet_type_trie[node].bet_type;
+    }
+    return bet_type_trie[node].completion;
+}
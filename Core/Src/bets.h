@@ -0,0 +1,28 @@
+#ifndef SRC_BETS_H_
+#define SRC_BETS_H_
+#include "payouts.h"
+#include <stdbool.h>
+
+#define BET_SLIP_SIZE 8 //maximum number of bets placed on one spin
+
+//structure to represent a single bet
+typedef struct {
+    uint8_t bet_id; //row of the payout matrix
+    uint32_t amount; //money staked on the bet
+} Bet;
+
+//structure to represent every bet placed on one spin
+typedef struct {
+    Bet bets[BET_SLIP_SIZE]; //placed bets
+    uint8_t count; //number of placed bets
+} BetSlip;
+
+void bet_slip_clear(BetSlip *);
+bool bet_slip_add(BetSlip *, uint8_t, uint32_t);
+bool bet_slip_full(const BetSlip *);
+uint32_t bet_slip_total(const BetSlip *);
+PocketMask bet_slip_pockets(const BetSlip *);
+uint32_t bet_slip_resolve(const BetSlip *, uint8_t);
+BetType parse_bet_type(const char *);
+
+#endif
@@ -0,0 +1,116 @@
+#include "bias.h"
+#include <math.h>
+#include <string.h>
+
+#define SECTOR_SHARE ((double)BIAS_SECTOR / ARR_SIZE) //share of results a sector expects
+
+//results over which a sector is z standard deviations over its share of n
+static double sector_limit(uint32_t n, double z) {
+    return (n * SECTOR_SHARE) + (z * sqrt(n * SECTOR_SHARE * (1 - SECTOR_SHARE)));
+}
+
+//start with no history, alerts fire over a chi-square of chi_limit or a sector z_limit
+//standard deviations over its share
+void bias_init(BiasDetector *bias, double chi_limit, double z_limit) {
+    memset(bias, 0, sizeof(BiasDetector));
+    bias->chi_limit = chi_limit;
+    bias->z_limit = z_limit;
+    //chi-square is ARR_SIZE * squares / n - n, over the limit when squares > n * (n + limit) / ARR_SIZE
+    bias->window_squares_limit = (uint32_t)(BIAS_WINDOW * (BIAS_WINDOW + chi_limit) / ARR_SIZE);
+    bias->window_sector_limit = (uint16_t)sector_limit(BIAS_WINDOW, z_limit);
+}
+
+//add the wheel index of a result, returns the alerts it raised
+//only the sectors holding the result can cross their limit, the rest drift back as the
+//history grows and are brought up to date the next time they are hit
+uint8_t bias_add(BiasDetector *bias, uint8_t index) {
+    uint8_t over = 0;
+    bias->squares += (2 * bias->counts[index]) + 1;
+    bias->counts[index]++;
+    bias->spins++;
+    double limit = sector_limit(bias->spins, bias->z_limit);
+    for (uint8_t i = 0; i < BIAS_SECTOR; i++) {
+        uint8_t first = (index + ARR_SIZE - i) % ARR_SIZE;
+        bias->sectors[first]++;
+        if (bias->sectors[first] > limit) {
+            bias->hot_sector = (bias->hot_sectors & POCKET_BIT(first)) ? bias->hot_sector : first;
+            bias->hot_sectors |= POCKET_BIT(first);
+        } else {
+            bias->hot_sectors &= ~POCKET_BIT(first);
+        }
+    }
+    if (bias->spins >= BIAS_MIN_SPINS) {
+        over |= (bias_chi_square(bias) > bias->chi_limit) ? BIAS_POCKETS : 0;
+        over |= (bias->hot_sectors != 0) ? BIAS_SECTORS : 0;
+    }
+
+    //the window takes the slot of the result BIAS_WINDOW spins back
+    uint16_t slot = (bias->spins - 1) % BIAS_WINDOW;
+    if (bias->spins > BIAS_WINDOW) {
+        uint8_t oldest = bias->window[slot];
+        bias->window_squares -= (2 * bias->window_counts[oldest]) - 1;
+        bias->window_counts[oldest]--;
+        for (uint8_t i = 0; i < BIAS_SECTOR; i++) {
+            uint8_t first = (oldest + ARR_SIZE - i) % ARR_SIZE;
+            bias->window_sectors[first]--;
+            if (bias->window_sectors[first] <= bias->window_sector_limit) {
+                bias->hot_window_sectors &= ~POCKET_BIT(first);
+            }
+        }
+    }
+    bias->window[slot] = index;
+    bias->window_squares += (2 * bias->window_counts[index]) + 1;
+    bias->window_counts[index]++;
+    for (uint8_t i = 0; i < BIAS_SECTOR; i++) {
+        uint8_t first = (index + ARR_SIZE - i) % ARR_SIZE;
+        bias->window_sectors[first]++;
+        if (bias->window_sectors[first] > bias->window_sector_limit) {
+            bias->hot_window_sector = (bias->hot_window_sectors & POCKET_BIT(first)) ? bias->hot_window_sector : first;
+            bias->hot_window_sectors |= POCKET_BIT(first);
+        }
+    }
+    if (bias->spins >= BIAS_WINDOW) {
+        over |= (bias->window_squares > bias->window_squares_limit) ? BIAS_WINDOW_POCKETS : 0;
+        over |= (bias->hot_window_sectors != 0) ? BIAS_WINDOW_SECTORS : 0;
+    }
+
+    //an alert stays active until its statistic has been under the limit for a whole window, so
+    //one sitting on its limit is raised once rather than every time it crosses
+    uint8_t raised = over & ~bias->active;
+    for (uint8_t kind = 0; kind < BIAS_ALERTS; kind++) {
+        uint8_t alert = 1 << kind;
+        if (over & alert) {
+            bias->quiet[kind] = 0;
+        } else if ((bias->active & alert) && ++bias->quiet[kind] >= BIAS_WINDOW) {
+            bias->active &= ~alert;
+        }
+    }
+    bias->active |= over;
+    return raised;
+}
+
+//chi-square of the pocket counts of the whole history against a fair wheel
+double bias_chi_square(const BiasDetector *bias) {
+    if (bias->spins == 0) {
+        return 0;
+    }
+    return ((double)ARR_SIZE * bias->squares / bias->spins) - bias->spins;
+}
+
+//chi-square of the pocket counts of the window against a fair wheel
+double bias_window_chi_square(const BiasDetector *bias) {
+    uint32_t n = (bias->spins < BIAS_WINDOW) ? bias->spins : BIAS_WINDOW;
+    if (n == 0) {
+        return 0;
+    }
+    return ((double)ARR_SIZE * bias->window_squares / n) - n;
+}
+
+//standard deviations a sector of the whole history is over its share, by first wheel index
+double bias_sector_z(const BiasDetector *bias, uint8_t first) {
+    if (bias->spins == 0) {
+        return 0;
+    }
+    double expected = bias->spins * SECTOR_SHARE;
+    return (bias->sectors[first] - expected) / sqrt(expected * (1 - SECTOR_SHARE));
+}
@@ -0,0 +1,57 @@
+#ifndef SRC_BIAS_H_
+#define SRC_BIAS_H_
+#include "spots.h"
+#include <stdbool.h>
+
+#define BIAS_WINDOW 512 //latest results in the sliding window, power of 2
+#define BIAS_SECTOR 9 //neighbouring wheel indexes in a sector
+#define BIAS_MIN_SPINS (5 * ARR_SIZE) //results before the whole history is tested
+#define BIAS_Z_LIMIT 4.0 //sector excess in standard deviations that raises an alert
+
+//chi-square on ARR_SIZE - 1 degrees of freedom with p = 0.001, raises a pocket alert
+#if WHEEL_ZEROS == 1
+#define BIAS_CHI_LIMIT 67.985
+#elif WHEEL_ZEROS == 2
+#define BIAS_CHI_LIMIT 69.346
+#else
+#define BIAS_CHI_LIMIT 70.703
+#endif
+
+//alerts, raised once as a statistic crosses its limit and again only after a whole window under it
+#define BIAS_POCKETS 0x01 //pocket counts of the whole history
+#define BIAS_WINDOW_POCKETS 0x02 //pocket counts of the window
+#define BIAS_SECTORS 0x04 //a sector of the whole history
+#define BIAS_WINDOW_SECTORS 0x08 //a sector of the window
+#define BIAS_ALERTS 4 //kinds of alert
+
+//streaming bias detector, a fixed ~1KB and O(1) work per result whatever the history length
+//sectors are the BIAS_SECTOR wheel indexes from each index in wheel_arr order, so a dealer
+//signature or a worn part of the rotor shows up as a sector hit more than its share
+typedef struct {
+    double chi_limit; //chi-square raising a pocket alert
+    double z_limit; //sector excess raising a sector alert
+    uint32_t window_squares_limit; //window sum of squares over chi_limit, fixed as the window is
+    uint16_t window_sector_limit; //window sector count over z_limit
+    uint32_t spins; //results added
+    uint32_t counts[ARR_SIZE]; //results per wheel index
+    uint64_t squares; //sum of counts squared, the chi-square follows from it
+    uint32_t sectors[ARR_SIZE]; //results per sector, by first wheel index
+    uint64_t hot_sectors; //sectors over the limit, bit per first wheel index
+    uint16_t window_counts[ARR_SIZE]; //window results per wheel index
+    uint32_t window_squares; //sum of window counts squared
+    uint16_t window_sectors[ARR_SIZE]; //window results per sector
+    uint64_t hot_window_sectors; //window sectors over the limit
+    uint8_t window[BIAS_WINDOW]; //latest results, the oldest is overwritten
+    uint16_t quiet[BIAS_ALERTS]; //results since each active alert was last over its limit
+    uint8_t active; //alerts raised and not yet quiet for a window
+    uint8_t hot_sector; //first wheel index of the last sector of the whole history over the limit
+    uint8_t hot_window_sector; //first wheel index of the last window sector over the limit
+} BiasDetector;
+
+void bias_init(BiasDetector *, double, double);
+uint8_t bias_add(BiasDetector *, uint8_t);
+double bias_chi_square(const BiasDetector *);
+double bias_window_chi_square(const BiasDetector *);
+double bias_sector_z(const BiasDetector *, uint8_t);
+
+#endif
@@ -0,0 +1,55 @@
+#include "chips.h"
+#include <stddef.h>
+
+//chips every player starts (and restarts) with
+const Chips starting_chips = {
+    .yellow = 0, //$1000 chips
+    .purple = 1, //$500 chips
+    .black = 5, //$100 chips
+    .orange = 10, //$50 chips
+    .green = 12, //$25 chips
+    .blue = 10, //$10 chips
+    .red = 16, //$5 chips
+    .white = 20 //$1 chips
+};
+
+//calculate total balance based on number of chips
+uint32_t calculate_total_balance(Chips chips) {
+    uint32_t total_balance = (chips.yellow * YELLOW_VAL) +
+                             (chips.purple * PURPLE_VAL) +
+                             (chips.black * BLACK_VAL) +
+                             (chips.orange * ORANGE_VAL) +
+                             (chips.green * GREEN_VAL) +
+                             (chips.blue * BLUE_VAL) +
+                             (chips.red * RED_VAL) +
+                             (chips.white * WHITE_VAL);
+    return total_balance;
+}
+
+//distribute winnings into chips, starting with highest chip amount
+void distribute_chips(uint32_t amount, Chips *chips) {
+    uint32_t chip_values[] = {YELLOW_VAL, PURPLE_VAL, BLACK_VAL, ORANGE_VAL, GREEN_VAL, BLUE_VAL, RED_VAL, WHITE_VAL};
+    uint32_t *chip_counts[] = {&chips->yellow, &chips->purple, &chips->black, &chips->orange, &chips->green, &chips->blue, &chips->red, &chips->white};
+    //distribute through all chip values if possible
+    for (uint8_t i = 0; i < POSSIBLE_CHIPS; i++) {
+        while (amount >= chip_values[i]) {
+            (*chip_counts[i])++;
+            amount -= chip_values[i];
+        }
+    }
+}
+
+//validate and get chip pointer for a given chip value
+uint32_t* get_chip_pointer(uint32_t chip_value, Chips *chips) {
+    switch (chip_value) {
+        case YELLOW_VAL: return &chips->yellow;
+        case PURPLE_VAL: return &chips->purple;
+        case BLACK_VAL: return &chips->black;
+        case ORANGE_VAL: return &chips->orange;
+        case GREEN_VAL: return &chips->green;
+        case BLUE_VAL: return &chips->blue;
+        case RED_VAL: return &chips->red;
+        case WHITE_VAL: return &chips->white;
+        default: return NULL;
+    }
+}
@@ -0,0 +1,49 @@
+#include "format.h"
+
+//decimal text of numbers without printf, which on newlib links a formatter many kilobytes
+//long that can reach for the heap. every function writes into a buffer the caller owns
+
+//write the decimal digits of a value, returns how many
+static uint8_t put_digits(char *text, uint32_t value) {
+    char reversed[FORMAT_DIGITS];
+    uint8_t length = 0;
+    do {
+        reversed[length++] = (char)('0' + (value % 10));
+        value /= 10;
+    } while (value > 0);
+    for (uint8_t i = 0; i < length; i++) {
+        text[i] = reversed[length - 1 - i];
+    }
+    return length;
+}
+
+//decimal text of a value, FORMAT_SIZE - 1 characters of room is enough, returns its length
+uint8_t format_number(char *text, uint32_t value) {
+    uint8_t length = put_digits(text, value);
+    text[length] = '\0';
+    return length;
+}
+
+//value in dollars, "$" and its digits, FORMAT_SIZE characters of room is enough, returns its
+//length
+uint8_t format_currency(char *text, uint32_t value) {
+    text[0] = '$';
+    return 1 + format_number(text + 1, value);
+}
+
+//value in a field of exactly width characters and a terminator, padded with spaces on the
+//other side from align. a value too wide for the field keeps its leading digits
+void format_field(char *text, uint32_t value, uint8_t width, FormatAlign align) {
+    char digits[FORMAT_DIGITS];
+    uint8_t length = put_digits(digits, value);
+    length = (length < width) ? length : width;
+    uint8_t pad = width - length;
+    uint8_t start = (align == ALIGN_RIGHT) ? pad : 0;
+    for (uint8_t i = 0; i < width; i++) {
+        text[i] = ' ';
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        text[start + i] = digits[i];
+    }
+    text[width] = '\0';
+}
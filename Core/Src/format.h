@@ -0,0 +1,18 @@
+#ifndef SRC_FORMAT_H_
+#define SRC_FORMAT_H_
+#include <stdint.h>
+
+#define FORMAT_DIGITS 10 //decimal digits of the largest uint32_t
+#define FORMAT_SIZE (FORMAT_DIGITS + 2) //room for the longest text, a dollar sign, the digits and a terminator
+
+//side of a fixed width field the text sits on, the rest is spaces
+typedef enum {
+    ALIGN_LEFT,
+    ALIGN_RIGHT
+} FormatAlign;
+
+uint8_t format_number(char *, uint32_t);
+uint8_t format_currency(char *, uint32_t);
+void format_field(char *, uint32_t, uint8_t, FormatAlign);
+
+#endif
@@ -1,21 +1,22 @@
 #include "main.h"
 #include "usart.h"
+#include "bets.h"
+#include "physics.h"
+#include "pacing.h"
+#include "bias.h"
 #include <stdbool.h>
 #include <stdlib.h>
 
 void SystemClock_Config(void);
-void handle_single_array_bet(const char **, uint8_t);
-void handle_double_array_bet(char *, const char **, uint8_t, uint8_t);
-
-#define SINGLE_ARR_SIZE 18
-#define NUM_SPLITS 61 //number of possible split bets
-#define NUM_STREETS 12 //number of possible street bets
-#define NUM_BASKETS 3 //number of possible basket bets
-#define NUM_CORNERS 22 //number of possible corner bets
-#define TOP_LINE_SIZE 5
-#define NUM_DUB_ST 11 //number of possible double street bets
-#define NUM_DOZ_COL 3 //number of possible dozen/column bets
+void handle_single_array_bet(BetType);
+void handle_double_array_bet(BetType);
+void wait_for_input(void);
+void wait_for_delay(uint32_t);
+
 #define DEL 2000 //1 second in milliseconds
+#define SPIN_DURATION_MS 6000 //wall time of a spin from launch to rest, whatever the physics took
+#define SPIN_EASE (PACING_EASE_FULL / 2) //launch shown at 1.5 and the landing at 0.5 times the even pace
+#define SPIN_TX_BUDGET 300 //bytes queued ahead of a wheel frame before it is dropped, about a frame of wire time at 115200 baud
 
 //game states
 typedef enum {
@@ -30,32 +31,34 @@ typedef enum {
 } GameState;
 
 volatile GameState current_state = INIT_ST; //current state of the game
+//names of the game states in the transmit report, indexed by GameState
+const char *state_names[USART_TX_STATES] = {"INIT", "TRADE", "BET_TYPE", "TABLE_UPDATE", "BET_MONEY",
+                                            "SPIN", "RESULT", "END"};
 volatile char usart_input_buffer[20]; //buffer for USART input
 volatile uint8_t usart_input_index = 0; //index for USART buffer
 volatile bool input_ready = false; //flag to indicate input is complete
 
 //player data
-Chips player_chips = {
-    .yellow = 0, //$1000 chips
-    .purple = 1, //$500 chips
-    .black = 5, //$100 chips
-    .orange = 10, //$50 chips
-    .green = 12, //$25 chips
-    .blue = 10, //$10 chips
-    .red = 16, //$5 chips
-    .white = 20 //$1 chips
-};
-
-volatile uint32_t bet_amount = 0; //current bet amount
-volatile char bet_type[20]; //type of bet
+Chips player_chips; //chips the player holds, dealt in main()
+
+BetSlip bet_slip = {0}; //bets placed for the next spin
+volatile BetType bet_type = BET_TYPE_NONE; //type of bet being placed
 
 //game data
 volatile uint32_t winning_index = 0; //winning number index
-volatile char winning_numbers[ARR_SIZE][3]; //buffer to store winning spots
-volatile uint8_t winning_numbers_count = 0; //count of winning numbers in the buffer
-volatile uint8_t spin_iterations = 0; //number of completed wheel iterations
+volatile uint8_t bet_id = 0; //payout matrix row of the bet being placed
+WheelSpin spin; //ball and rotor of the current spin
+SpinPacing spin_pacing; //frames the current spin is shown in and the step each one shows
+volatile uint32_t spin_frame = 0; //wheel frames since the ball was launched
+volatile uint32_t spin_step = 0; //physics step shown, where the pacing has got the ball to
 volatile uint8_t spin_index = 0; //current wheel index during spinning
 volatile bool spin_complete = false; //flag to indicate the spin is done
+BiasDetector wheel_bias; //pocket and sector bias of every spin since power up
+volatile bool frame_pending = false; //the timer has moved the ball since the last wheel frame was drawn
+volatile uint32_t frames_posted = 0; //wheel frames the timer asked for this spin
+uint32_t frames_drawn = 0; //wheel frames the main loop drew this spin, the rest were skipped
+uint32_t frames_dropped = 0; //wheel frames skipped this spin because the transmit backlog was over budget
+IsrTiming tim2_timing = {0}; //run time of TIM2_IRQHandler
 
 int main(void) {
 	HAL_Init();
@@ -65,13 +68,17 @@ int main(void) {
 	USART_init();
 	RNG_init();
 	TIM2_init();
+	DWT_init();
+	player_chips = starting_chips; //deal the starting chips
+	bias_init(&wheel_bias, BIAS_CHI_LIMIT, BIAS_Z_LIMIT);
 	USART_start_screen();
 	USART_print_wheel(wheel_arr, 0);
-	USART_print_table(base_table_arr);
-	USART_print_chips(&player_chips, bet_amount);
+	USART_print_table(0);
+	USART_print_chips(&player_chips, bet_slip_total(&bet_slip));
 	__enable_irq(); //enable interrupts globally
 
 	while (1) { //infinte program flow
+		USART_tx_state(current_state); //count what this state sends against it
 		switch (current_state) { //state machine
 			case INIT_ST: //start point of game
 				//print start message
@@ -80,13 +87,13 @@ int main(void) {
 				USART_ESC_Code(CLEAR_LINE);
 				USART_print_string("Welcome to Roulette! Press Enter to begin.");
 
-				while (!input_ready); //wait for user input
-				input_ready = false; //reset input flag
+				wait_for_input(); //wait for user input
 
 				USART_ESC_Code(CLEAR_LINE);
 				USART_ESC_Code(FULLY_LEFT);
 				USART_print_string("Starting game...");
-				HAL_Delay(DEL); //2 second delay
+				wait_for_delay(DEL); //2 second delay
+				USART_tx_flush(); //the whole start screen is up before the game starts, however quick the answer
 
 				current_state = TRADE_ST; //transition to trading state
 				break;
@@ -98,8 +105,7 @@ int main(void) {
 					USART_ESC_Code(FULLY_LEFT);
 					USART_print_string("Trade in chips? (yes/no) --> ");
 
-					while (!input_ready); //wait for user input
-					input_ready = false; //reset input flag
+					wait_for_input(); //wait for user input
 
 					//transition to betting type state if the answer is not "yes"
 					if (strcmp(usart_input_buffer, "yes") != 0) {
@@ -120,8 +126,7 @@ int main(void) {
 			            USART_ESC_Code(FULLY_LEFT);
 			            USART_print_string("Enter chip value to trade in --> ");
 
-						while (!input_ready); //wait for user input
-						input_ready = false; //reset input flag
+						wait_for_input(); //wait for user input
 
 						//validate and record chip value
 			            chip_value_in = atoi(usart_input_buffer);
@@ -130,7 +135,7 @@ int main(void) {
 		                    USART_ESC_Code(CLEAR_LINE);
 		                    USART_ESC_Code(FULLY_LEFT);
 		                    USART_print_string("Cannot trade in $1 chips! Please enter a higher chip value.");
-		                    HAL_Delay(DEL); //2 second delay
+		                    wait_for_delay(DEL); //2 second delay
 		                    continue; //retry for valid input
 			            }
 			            //assign pointer to corresponding chip value in player chips
@@ -140,16 +145,15 @@ int main(void) {
 		                    USART_ESC_Code(CLEAR_LINE);
 		                    USART_ESC_Code(FULLY_LEFT);
 		                    USART_print_string("Invalid chip value! Please enter a valid chip value.");
-		                    HAL_Delay(DEL); //2 second delay
+		                    wait_for_delay(DEL); //2 second delay
 		                    continue; //retry for valid input
 			            } else if (*chip_ptr_in == 0) { //check if out of those chips
 		                    USART_ESC_Code(CLEAR_LINE);
 		                    USART_ESC_Code(FULLY_LEFT);
 							USART_print_string("You are out of ");
-							snprintf(usart_input_buffer, sizeof(usart_input_buffer), "$%lu", chip_value_in);
-							USART_print_string(usart_input_buffer);
+							USART_print_currency(chip_value_in);
 							USART_print_string(" chips! Please enter a different chip value.");
-		                    HAL_Delay(DEL); //2 second delay
+		                    wait_for_delay(DEL); //2 second delay
 		                    continue; //retry for valid input
 			            }
 			            break;
@@ -160,12 +164,10 @@ int main(void) {
 						USART_ESC_Code(CLEAR_LINE);
 						USART_ESC_Code(FULLY_LEFT);
 						USART_print_string("Enter quantity of ");
-						snprintf(usart_input_buffer, sizeof(usart_input_buffer), "$%lu", chip_value_in);
-						USART_print_string(usart_input_buffer);
+						USART_print_currency(chip_value_in);
 						USART_print_string(" chips to trade in --> ");
 
-						while (!input_ready); //wait for user input
-						input_ready = false; //reset input flag
+						wait_for_input(); //wait for user input
 
 						//validate chip quantity
 						chip_quantity_in = atoi(usart_input_buffer);
@@ -173,7 +175,7 @@ int main(void) {
 							USART_ESC_Code(CLEAR_LINE);
 							USART_ESC_Code(FULLY_LEFT);
 							USART_print_string("Not enough chips to trade in! Please enter a lower quantity.");
-							HAL_Delay(DEL); //2 second delay
+							wait_for_delay(DEL); //2 second delay
 							continue;
 						}
 						break;
@@ -185,8 +187,7 @@ int main(void) {
 			            USART_ESC_Code(FULLY_LEFT);
 			            USART_print_string("Enter chip value you want in return --> ");
 
-						while (!input_ready); //wait for user input
-						input_ready = false; //reset input flag
+						wait_for_input(); //wait for user input
 
 						//validate and record chip value
 			            chip_value_out = atoi(usart_input_buffer);
@@ -195,7 +196,7 @@ int main(void) {
 			                USART_ESC_Code(CLEAR_LINE);
 			                USART_ESC_Code(FULLY_LEFT);
 			                USART_print_string("Chip value must be lower than trade-in chip value! Try again.");
-			                HAL_Delay(DEL); //2 second delay
+			                wait_for_delay(DEL); //2 second delay
 			                continue;
 			            }
 			            //assign pointer to corresponding chip value being traded in for
@@ -205,7 +206,7 @@ int main(void) {
 		                    USART_ESC_Code(CLEAR_LINE);
 		                    USART_ESC_Code(FULLY_LEFT);
 		                    USART_print_string("Invalid chip value! Please enter a valid chip value.");
-		                    HAL_Delay(DEL); //2 second delay
+		                    wait_for_delay(DEL); //2 second delay
 		                    continue; //retry for valid input
 			            }
 			            //validate that the lower value fits evenly into the higher value
@@ -213,7 +214,7 @@ int main(void) {
 			                USART_ESC_Code(CLEAR_LINE);
 			                USART_ESC_Code(FULLY_LEFT);
 			                USART_print_string("Trade-in value must be divisible by the desired value! Try again.");
-			                HAL_Delay(DEL); //2 second delay
+			                wait_for_delay(DEL); //2 second delay
 			                continue;
 			            }
 			            break;
@@ -225,123 +226,94 @@ int main(void) {
 			        *chip_ptr_out += possible_out;
 
 			        //update the display
-			        USART_print_chips(&player_chips, bet_amount);
+			        USART_print_chips(&player_chips, bet_slip_total(&bet_slip));
 			        //notify the user of the transaction
 					USART_ESC_Code(TOP_LEFT);
 					USART_ESC_Code(DOWN_35);
 			        USART_ESC_Code(CLEAR_LINE);
 			        USART_ESC_Code(FULLY_LEFT);
 			        USART_print_string("Trade in complete! You traded ");
-			        snprintf(usart_input_buffer, sizeof(usart_input_buffer), "%lu", chip_quantity_in);
-			        USART_print_string(usart_input_buffer);
-			        USART_print_string(" $");
-			        snprintf(usart_input_buffer, sizeof(usart_input_buffer), "%lu", chip_value_in);
-			        USART_print_string(usart_input_buffer);
+			        USART_print_number(chip_quantity_in);
+			        USART_print_char(' ');
+			        USART_print_currency(chip_value_in);
 			        USART_print_string(" chips for ");
-			        snprintf(usart_input_buffer, sizeof(usart_input_buffer), "%lu", possible_out);
-			        USART_print_string(usart_input_buffer);
-			        USART_print_string(" $");
-			        snprintf(usart_input_buffer, sizeof(usart_input_buffer), "%lu", chip_value_out);
-			        USART_print_string(usart_input_buffer);
+			        USART_print_number(possible_out);
+			        USART_print_char(' ');
+			        USART_print_currency(chip_value_out);
 			        USART_print_string(" chips.");
-			        HAL_Delay(2 * DEL); //4 second delay
+			        wait_for_delay(2 * DEL); //4 second delay
 			    }
 
 			case BET_TYPE_ST: //determine the type of bet the user wants
+				USART_tx_state(BET_TYPE_ST); //trading falls through to here
 				//ask for the type of bet
 				USART_ESC_Code(CLEAR_LINE);
 				USART_ESC_Code(FULLY_LEFT);
 				USART_print_string("Choose your bet type (from above) --> ");
 
-				while (!input_ready); //wait for user input
-				input_ready = false; //reset input flag
+				wait_for_input(); //wait for user input
 
-				//store the chosen bet type in a global variable for later use
-				strncpy(bet_type, usart_input_buffer, sizeof(bet_type) - 1);
-				bet_type[sizeof(bet_type) - 1] = '\0'; //ensure null termination
+				//parse the bet type once, unique prefixes are completed ("Dou" -> "Double Street")
+				bet_type = parse_bet_type(usart_input_buffer);
 
-				if (strcmp(bet_type, "Straight") == 0) { //straight bet
-					//ask for the number
-					USART_ESC_Code(CLEAR_LINE);
-					USART_ESC_Code(FULLY_LEFT);
-					USART_print_string("Enter number (00-36) --> ");
+				switch (bet_type) {
+					case BET_STRAIGHT: //straight bet
+						//ask for the number
+						USART_ESC_Code(CLEAR_LINE);
+						USART_ESC_Code(FULLY_LEFT);
+						USART_print_string("Enter number (" POCKET_RANGE ") --> ");
+
+						wait_for_input(); //wait for user input
 
-					while (!input_ready); //wait for user input
-					input_ready = false; //reset input flag
+						//validate the number and select its straight bet
+						uint8_t pocket = spot_to_pocket(usart_input_buffer);
+						if (pocket != POCKET_INVALID) {
+							bet_id = bet_type_first_id[BET_STRAIGHT] + pocket;
 
-					//validate the number and update the winning numbers array
-					if (strcmp(usart_input_buffer, "00") == 0 ||
-					   (atoi(usart_input_buffer) >= 0 && atoi(usart_input_buffer) <= 36)) {
-						winning_numbers_count = 0;
-						strncpy(winning_numbers[winning_numbers_count++], usart_input_buffer, 3);
+							current_state = TABLE_UPDATE_ST; //move to betting amount state
+						} else {
+							//invalid number
+							USART_ESC_Code(CLEAR_LINE);
+							USART_ESC_Code(FULLY_LEFT);
+							USART_print_string("Invalid bet! Number you entered does not exist on the wheel.");
+							wait_for_delay(DEL); //2 second delay
 
-						current_state = TABLE_UPDATE_ST; //move to betting amount state
-					} else {
-						//invalid number
+							current_state = BET_TYPE_ST; //remain in betting type state
+						}
+						break;
+					case BET_SPLIT: //bets with several possible positions
+					case BET_STREET:
+					case BET_BASKET:
+					case BET_CORNER:
+					case BET_DOUBLE_STREET:
+					case BET_DOZEN:
+					case BET_COLUMN:
+						handle_double_array_bet(bet_type);
+						break;
+					case BET_TOP_LINE: //bets with a single position
+					case BET_RED:
+					case BET_BLACK:
+					case BET_ODD:
+					case BET_EVEN:
+					case BET_LOW:
+					case BET_HIGH:
+						handle_single_array_bet(bet_type);
+						break;
+					default:
+						//invalid bet type
 						USART_ESC_Code(CLEAR_LINE);
 						USART_ESC_Code(FULLY_LEFT);
-						USART_print_string("Invalid bet! Number you entered does not exist on the wheel.");
-						HAL_Delay(DEL); //2 second delay
+						USART_print_string("Invalid bet type! Choose one from the list above.");
+						wait_for_delay(DEL); //2 second delay
 
 						current_state = BET_TYPE_ST; //remain in betting type state
-					}
-				} else if (strcmp(bet_type, "Split") == 0) { //split bet
-					handle_double_array_bet("split", split_bets, NUM_SPLITS, SPLIT_SIZE);
-				} else if (strcmp(bet_type, "Street") == 0) { //street bet
-					handle_double_array_bet("street", street_bets, NUM_STREETS, ST_SIZE);
-				} else if (strcmp(bet_type, "Basket") == 0) { //basket bet
-					handle_double_array_bet("basket", basket_bets, NUM_BASKETS, BASKET_SIZE);
-				} else if (strcmp(bet_type, "Corner") == 0) { //corner bet
-					handle_double_array_bet("corner", corner_bets, NUM_CORNERS, CORNER_SIZE);
-				} else if (strcmp(bet_type, "Top Line") == 0) { //top line bet
-					handle_single_array_bet(top_line, TOP_LINE_SIZE);
-				} else if (strcmp(bet_type, "Double Street") == 0) { //double street bet
-					handle_double_array_bet("double street", double_street_bets, NUM_DUB_ST, DUB_ST_SIZE);
-				} else if (strcmp(bet_type, "Dozen") == 0) { //dozen bet
-					handle_double_array_bet("dozen", dozen_bets, NUM_DOZ_COL, DOZ_COL_SIZE);
-				} else if (strcmp(bet_type, "Column") == 0) { //column bet
-					handle_double_array_bet("column", column_bets, NUM_DOZ_COL, DOZ_COL_SIZE);
-				} else if (strcmp(bet_type, "Red") == 0 || strcmp(bet_type, "Black") == 0) { //color bet
-					const char **selected_color = (strcmp(bet_type, "Red") == 0)
-													? red
-													: black;
-					handle_single_array_bet(selected_color, SINGLE_ARR_SIZE);
-				} else if (strcmp(bet_type, "Odd") == 0 || strcmp(bet_type, "Even") == 0) { //odd/even bet
-				  const char **selected_parity = (strcmp(bet_type, "Odd") == 0)
-													? odds
-													: evens;
-				  handle_single_array_bet(selected_parity, SINGLE_ARR_SIZE);
-				} else if (strcmp(bet_type, "Low") == 0 || strcmp(bet_type, "High") == 0) { //high/low bet
-				  const char **selected_range = (strcmp(bet_type, "Low") == 0)
-													? low_half
-													: high_half;
-				  handle_single_array_bet(selected_range, SINGLE_ARR_SIZE);
-				} else {
-					//invalid bet type
-					USART_ESC_Code(CLEAR_LINE);
-					USART_ESC_Code(FULLY_LEFT);
-					USART_print_string("Invalid bet type! Choose one from the list above.");
-					HAL_Delay(DEL); //2 second delay
-
-					current_state = BET_TYPE_ST; //remain in betting type state
+						break;
 				}
 				break;
 
 			case TABLE_UPDATE_ST:
-				//create a dynamic array to copy the base table spots
-				Spot dynamic_table[ARR_SIZE];
-				memcpy(dynamic_table, base_table_arr, sizeof(base_table_arr));
-
-				//highlight the winning spots in the dynamic array
-				for (uint8_t i = 0; i < winning_numbers_count; i++) {
-				  for (uint8_t j = 0; j < ARR_SIZE; j++) {
-					  if (strcmp(winning_numbers[i], dynamic_table[j].number + (dynamic_table[j].number[0] == ' ' ? 1 : 0)) == 0) {
-						  strcpy(dynamic_table[j].color, "cyan"); //highlight winning spot
-						  }
-				  }
-				}
-				//print the updated table
-				USART_print_table(dynamic_table);
+				//print the table with the spots covered by this bet and the bets already on the slip highlighted
+				USART_print_table(bet_pockets[bet_id] | bet_slip_pockets(&bet_slip));
 
 				current_state = BET_MONEY_ST; //transition to betting money state
 				break;
@@ -351,6 +323,7 @@ int main(void) {
 				uint32_t chip_value = 0;
 				uint32_t chip_quantity = 0;
 				uint32_t total_bet = 0;
+				uint32_t slip_total = bet_slip_total(&bet_slip);
 
 				//run continuously while in this state
 				while (1) {
@@ -360,16 +333,15 @@ int main(void) {
 					USART_ESC_Code(CLEAR_LINE);
 					USART_print_string("Enter chip value to bet or 'done' --> ");
 
-					while (!input_ready); //wait for user input
-					input_ready = false; //reset input flag
+					wait_for_input(); //wait for user input
 
-					//check if the user is done betting
+					//check if the user is done betting, with nothing staked here the slip spins as it is
 					if (strcmp(usart_input_buffer, "done") == 0) {
-						if (total_bet == 0) {
+						if (total_bet == 0 && bet_slip.count == 0) {
 		                    USART_ESC_Code(CLEAR_LINE);
 		                    USART_ESC_Code(FULLY_LEFT);
 		                    USART_print_string("You must bet before spinning the wheel!");
-		                    HAL_Delay(DEL); //2 second delay
+		                    wait_for_delay(DEL); //2 second delay
 		                    continue; //retry for valid input
 						}
 						break;
@@ -385,7 +357,7 @@ int main(void) {
 	                    USART_ESC_Code(CLEAR_LINE);
 	                    USART_ESC_Code(FULLY_LEFT);
 	                    USART_print_string("Invalid chip value! Please enter a valid chip value.");
-	                    HAL_Delay(DEL); //2 second delay
+	                    wait_for_delay(DEL); //2 second delay
 	                    continue; //retry for valid input
 		            }
 
@@ -394,8 +366,7 @@ int main(void) {
 					USART_ESC_Code(FULLY_LEFT);
 					USART_print_string("Enter quantity of chips --> ");
 
-					while (!input_ready); //wait for user input
-					input_ready = false; //reset input flag
+					wait_for_input(); //wait for user input
 
 					//validate chip quantity
 					chip_quantity = atoi(usart_input_buffer);
@@ -404,19 +375,34 @@ int main(void) {
 						USART_ESC_Code(CLEAR_LINE);
 						USART_ESC_Code(FULLY_LEFT);
 						USART_print_string("Not enough chips! Please enter a lower quantity or different value.");
-						HAL_Delay(DEL); //2 second delay
+						wait_for_delay(DEL); //2 second delay
 						continue;
 					}
 					//calculate the total bet and update chip counts
 					total_bet += chip_value * chip_quantity;
 					*chip_ptr -= chip_quantity;
 					//update chip and balance display
-					USART_print_chips(&player_chips, total_bet);
+					USART_print_chips(&player_chips, slip_total + total_bet);
 				}
-				//update global bet amount
-				bet_amount = total_bet;
-
 				current_state = SPIN_ST; //transition to spin state
+				if (total_bet == 0) {
+					break; //nothing staked on this bet, spin the bets already on the slip
+				}
+				//add the bet to the slip
+				bet_slip_add(&bet_slip, bet_id, total_bet);
+
+				//offer another bet while the slip has room and the player has chips left to stake
+				if (!bet_slip_full(&bet_slip) && calculate_total_balance(player_chips) > 0) {
+					USART_ESC_Code(CLEAR_LINE);
+					USART_ESC_Code(FULLY_LEFT);
+					USART_print_string("Place another bet? (yes/no) --> ");
+
+					wait_for_input(); //wait for user input
+
+					if (strcmp(usart_input_buffer, "yes") == 0) {
+						current_state = BET_TYPE_ST; //transition to betting type state
+					}
+				}
 				break;
 
 			case SPIN_ST:
@@ -425,19 +411,32 @@ int main(void) {
 				USART_ESC_Code(FULLY_LEFT);
 				USART_print_string("Press Enter to spin the wheel...");
 
-				while (!input_ready); //wait for user input
-				input_ready = false; //reset input flag
+				wait_for_input(); //wait for user input
 
 				//message while spinning
 				USART_ESC_Code(CLEAR_LINE);
 				USART_ESC_Code(FULLY_LEFT);
 				USART_print_string("Spinning...");
-				//get winning index using RNG
-				winning_index = RNG_get_random_number() % ARR_SIZE;
+				//get winning index using RNG, unbiased and from words the RNG interrupt prefetched
+				winning_index = RNG_get_random_below(ARR_SIZE);
+				//launch the ball from fresh random words and turn the rotor so it lands on the winning index
+				uint32_t launch_words[PHYSICS_WORDS];
+				for (uint8_t i = 0; i < PHYSICS_WORDS; i++) {
+					launch_words[i] = RNG_get_random_number();
+				}
+				physics_launch(&spin, &wheel_physics, launch_words);
+				physics_land_on(&spin, winning_index);
+				//show the spin in a set time whatever the physics took
+				pacing_init(&spin_pacing, spin.rest_step, SPIN_DURATION_MS, SPIN_EASE);
 				//reset spinning variables
-				spin_iterations = 0;
-				spin_index = 0;
+				spin_frame = 0;
+				spin_step = 0;
+				spin_index = physics_index_at(&spin, 0);
 				spin_complete = false;
+				frame_pending = false;
+				frames_posted = 0;
+				frames_drawn = 0;
+				frames_dropped = 0;
 
 				GPIOC->ODR |= YELLOW_PIN; //turn on yellow LED to alternate with blue
 				//enable the timer to start spinning
@@ -445,8 +444,21 @@ int main(void) {
 				TIM2->DIER |= TIM_DIER_UIE; //enable update interrupt
 				TIM2->SR &= ~TIM_SR_UIF; //clear update flag
 
-				//wait for spin to complete
-				while (!spin_complete);
+				//draw each frame the timer posts until the ball comes to rest, only the latest
+				//position is drawn so frames posted while one is still going out are skipped, and
+				//a frame is dropped while the transmit ring holds more than the budget ahead of it
+				while (!spin_complete || frame_pending) {
+					if (frame_pending) {
+						frame_pending = false;
+						UsartTxStats tx = USART_tx_stats();
+						if (pacing_draw(tx.queued - tx.sent, SPIN_TX_BUDGET, spin_complete)) {
+							USART_print_wheel(wheel_arr, spin_index);
+							frames_drawn++;
+						} else {
+							frames_dropped++;
+						}
+					}
+				}
 
 				GPIOC->ODR &= ~(YELLOW_PIN | BLUE_PIN); //turn off LEDs
 				//disable the timer to stop spinning
@@ -459,40 +471,20 @@ int main(void) {
 
 			case RESULT_ST:
 				//reset the table to unhighlighted values
-				Spot unhighlighted_table[ARR_SIZE];
-				memcpy(unhighlighted_table, base_table_arr, sizeof(base_table_arr));
-				USART_print_table(unhighlighted_table);
+				USART_print_table(0);
 				//retrieve the winning spot
 				Spot winning_spot = wheel_arr[winning_index];
-				//check if the winning spot is in the winning numbers array
-				bool user_won = false;
-				for (uint8_t i = 0; i < winning_numbers_count; i++) {
-				  if (strcmp(winning_numbers[i], winning_spot.number + (winning_spot.number[0] == ' ' ? 1 : 0)) == 0) {
-					  user_won = true;
-					  break;
-				  }
-				}
-				//calculate winnings or losses
-				uint32_t net_gain = 0; //net gain or loss
-				if (user_won) {
-					//calculate winnings based on bet type odds
-					uint32_t winnings = bet_amount * calculate_odds(bet_type);
-					net_gain = winnings; //net gain
+				//resolve every bet on the slip against the winning spot
+				uint32_t total_staked = bet_slip_total(&bet_slip);
+				uint32_t winnings = bet_slip_resolve(&bet_slip, winning_spot);
+				bool user_won = winnings > total_staked;
+				if (winnings > 0) {
 					distribute_chips(winnings, &player_chips); //distribute winnings back as chips
-				} else {
-					net_gain = bet_amount; //net loss
 				}
-				//prepare result message
-				char result_message[25];
-				if (user_won) {
-				  snprintf(result_message, sizeof(result_message), "You won $%ld! ", (net_gain - bet_amount));
-				} else {
-				  snprintf(result_message, sizeof(result_message), "You lost $%ld. ", net_gain);
-				}
-				//reset bet amount
-				bet_amount = 0;
+				//clear the slip
+				bet_slip_clear(&bet_slip);
 				//update the chips and balance display
-				USART_print_chips(&player_chips, bet_amount);
+				USART_print_chips(&player_chips, bet_slip_total(&bet_slip));
 				//navigate to message section
 				USART_ESC_Code(TOP_LEFT);
 				USART_ESC_Code(DOWN_35);
@@ -507,16 +499,34 @@ int main(void) {
 					USART_print_string("Better luck next time! ");
 					GPIOB->ODR |= LED_PINS;
 				}
-				USART_print_string(result_message);
-				HAL_Delay(2.5 * DEL); //5 second delay
+				//net result of the spin
+				if (user_won) {
+					USART_print_string("You won ");
+					USART_print_currency(winnings - total_staked);
+					USART_print_string("! ");
+				} else if (winnings == total_staked) {
+					USART_print_string("You broke even. ");
+				} else {
+					USART_print_string("You lost ");
+					USART_print_currency(total_staked - winnings);
+					USART_print_string(". ");
+				}
+				//flag the wheel when its history stops looking fair
+				uint8_t bias_alerts = bias_add(&wheel_bias, winning_index);
+				if (bias_alerts & (BIAS_SECTORS | BIAS_WINDOW_SECTORS)) {
+					USART_print_string("Wheel check: sector bias!");
+				} else if (bias_alerts != 0) {
+					USART_print_string("Wheel check: pocket bias!");
+				}
+				wait_for_delay(2.5 * DEL); //5 second delay
 
 				current_state = END_ST; //transition to end state
 
 			case END_ST:
 			    //reset bet-related variables
-			    memset(bet_type, 0, sizeof(bet_type));     // clear the bet type
-			    memset(winning_numbers, 0, sizeof(winning_numbers)); // clear the winning numbers array
-			    winning_numbers_count = 0;                //reset winning numbers count
+			    bet_type = BET_TYPE_NONE;                 //clear the bet type
+			    bet_id = 0;                               //clear the selected bet
+			    bet_slip_clear(&bet_slip);                //clear the bet slip
 			    //check if the player is out of chips
 			    if (calculate_total_balance(player_chips) == 0) {
 			        //inform the user that they are out of chips
@@ -526,24 +536,14 @@ int main(void) {
 			        USART_ESC_Code(FULLY_LEFT);
 			        USART_print_string("You are out of chips! Type 'reset' to start over --> ");
 
-					while (!input_ready); //wait for user input
-					input_ready = false; //reset input flag
+					wait_for_input(); //wait for user input
 
 					//if user want to reset
 			        if (strcmp(usart_input_buffer, "reset") == 0) {
 			            //reset the player's chips to the initial state
-			            player_chips = (Chips) {
-			                .yellow = 0, //$1000 chips
-			                .purple = 1, //$500 chips
-			                .black = 5, //$100 chips
-			                .orange = 10, //$50 chips
-			                .green = 12, //$25 chips
-			                .blue = 10, //$10 chips
-			                .red = 16, //$5 chips
-			                .white = 20 //$1 chips
-			            };
+			            player_chips = starting_chips;
 			            //update the chips and balance display
-			            USART_print_chips(&player_chips, bet_amount);
+			            USART_print_chips(&player_chips, bet_slip_total(&bet_slip));
 
 			            current_state = INIT_ST; //transition back to initial state
 			        } else {
@@ -558,8 +558,7 @@ int main(void) {
 			        //inform the user that they can play again
 			        USART_print_string("Press Enter to play again!");
 
-					while (!input_ready); //wait for user input
-					input_ready = false; //reset input flag
+					wait_for_input(); //wait for user input
 
 			        current_state = TRADE_ST; //transition to trade state
 			    }
@@ -571,8 +570,39 @@ int main(void) {
 	}
 }
 
+//wait for the user to enter a line, painting the rest of the start screen meanwhile
+//the transmit report command is answered here at any prompt and the line taken again after it
+void wait_for_input(void) {
+	while (1) {
+		USART_tx_input_start(); //the echo from here is taken back if the line is the report command
+		while (!input_ready) {
+			USART_paint_screen();
+		}
+		input_ready = false; //reset input flag
+		if (strcmp(usart_input_buffer, TX_REPORT_COMMAND) != 0) {
+			break;
+		}
+		//no painting while the report is up, it would land on the report
+		//no spin runs at a prompt, so the timer leaves the spin counters alone while they are copied
+		UsartSpinStats spin_stats = {tim2_timing, frames_posted, frames_drawn, frames_dropped};
+		USART_open_tx_report(state_names, &spin_stats);
+		while (!input_ready); //wait for Enter
+		input_ready = false;
+		USART_close_tx_report();
+	}
+}
+
+//wait for a message to be read, painting the rest of the start screen meanwhile
+void wait_for_delay(uint32_t ms) {
+	uint32_t start = HAL_GetTick();
+	while ((HAL_GetTick() - start) < ms) {
+		USART_paint_screen();
+	}
+}
+
 //ISR for USART2
 void USART2_IRQHandler(void) {
+	UsartRegion region = USART_tx_region(REGION_PROMPT); //the echo belongs to the prompt line
 	//check if RXNE flag is set
     if (USART2->ISR & USART_ISR_RXNE) {
         char c = USART2->RDR; //read received character
@@ -597,68 +627,63 @@ void USART2_IRQHandler(void) {
             }
         }
     }
+    USART_tx_region(region);
 }
 
 //ISR for TIM2
+//only advances the ball and posts a frame, the main loop draws it, so the handler runs in
+//a fixed few hundred cycles (tim2_timing, shown by the transmit report) instead of the whole
+//wheel frame going out
 void TIM2_IRQHandler(void) {
+	uint32_t isr_start = DWT->CYCCNT;
 	//check if update flag is set
     if (TIM2->SR & TIM_SR_UIF) {
         TIM2->SR &= ~TIM_SR_UIF; //clear update flag
         if (!spin_complete) {
-            //simulate wheel spinning
-            spin_index = (spin_index + 1) % ARR_SIZE;
-            USART_print_wheel(wheel_arr, spin_index);
+            //advance the ball one frame along the pacing and post the pocket under it
+            spin_frame++;
+            spin_step = pacing_step(&spin_pacing, spin_frame);
+            spin_index = physics_index_at(&spin, spin_step);
+            frame_pending = true;
+            frames_posted++;
             //alternate yellow and blue LEDs at visible rate
-            if (spin_index % 9 == 0) {
+            if (spin_frame % 9 == 0) {
             	GPIOC->ODR ^= (YELLOW_PIN | BLUE_PIN);
             }
-            //check if we completed the spin
-            if (spin_iterations >= 5 && spin_index == winning_index) {
+            //check if the ball has come to rest, it is in the winning pocket
+            if (spin_frame + 1 >= spin_pacing.frames) {
                 spin_complete = true;
             }
-            //increment iteration count if we completed a full spin
-            if (spin_index == 0) {
-                spin_iterations++;
-            }
         }
     }
+    ISR_timing_end(&tim2_timing, isr_start);
 }
 
-//handle bets that are stored in a single array
-void handle_single_array_bet(const char **bet_array, uint8_t array_size) {
-    //clear the winning numbers count
-    winning_numbers_count = 0;
-    //copy all numbers from the bet array to the winning_numbers array
-    for (uint8_t i = 0; i < array_size; i++) {
-        strncpy(winning_numbers[winning_numbers_count++], bet_array[i], 3);
-    }
+//handle bets that have a single row in the payout matrix
+void handle_single_array_bet(BetType type) {
+    bet_id = bet_type_first_id[type]; //select the bet
 
     current_state = TABLE_UPDATE_ST; //transition to table update state
 }
 
-//handle bets that are stored in a double array
-void handle_double_array_bet(char *bet_name, const char **bet_array, uint8_t row_size, uint8_t col_size) {
+//handle bets that have one payout matrix row per table row
+void handle_double_array_bet(BetType type) {
+    uint8_t first_id = bet_type_first_id[type];
+    uint8_t row_size = bet_type_first_id[type + 1] - first_id;
     //ask the user for the index of the row in the double array
     USART_ESC_Code(CLEAR_LINE);
     USART_ESC_Code(FULLY_LEFT);
     USART_print_string("Enter ");
-    USART_print_string(bet_name);
+    USART_print_string((char *)bet_type_names[type]);
     USART_print_string(" number (refer to user manual or table) --> ");
 
-	while (!input_ready); //wait for user input
-	input_ready = false; //reset input flag
+	wait_for_input(); //wait for user input
 
     //validate the input
     uint8_t index = atoi(usart_input_buffer) - 1; //convert to 0-based index
     if (index >= 0 && index < row_size) {
-        //clear the winning numbers count
-        winning_numbers_count = 0;
-        //access the correct row
-        const char **row = bet_array + (index * col_size);
-        //copy all numbers from the selected row to the winning_numbers array
-        for (uint8_t i = 0; i < col_size; i++) {
-            strncpy(winning_numbers[winning_numbers_count++], row[i], 3);
-        }
+        //select the bet for the chosen row
+        bet_id = first_id + index;
 
         current_state = TABLE_UPDATE_ST; //transition to table update state
     } else {
@@ -666,7 +691,7 @@ void handle_double_array_bet(char *bet_name, const char **bet_array, uint8_t row
         USART_ESC_Code(CLEAR_LINE);
         USART_ESC_Code(FULLY_LEFT);
         USART_print_string("Invalid number! The number you entered does not exist on the table.");
-        HAL_Delay(DEL); //2 second delay
+        wait_for_delay(DEL); //2 second delay
 
         current_state = BET_TYPE_ST; //remain in the betting type state
     }
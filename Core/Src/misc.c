@@ -1,7 +1,16 @@
 #include "misc.h"
+#include "physics.h"
 
 #define RNG_MULT 24 //clock configuration multiplier
-#define ARR_VAL 2105263 //full wheel spin in 1 second
+#define ARR_VAL (80000000 / PHYSICS_FRAME_HZ) //one wheel frame at the 80MHz clock
+#define RNG_RING_MASK (RNG_RING_SIZE - 1) //ring index from a free running count
+#define NVIC_MASK 0x1F //mask bottom 5 bits
+
+//random words filled by RNG_IRQHandler and taken by RNG_get_random_number, single producer
+//and single consumer so the free running counts need no lock
+static volatile uint32_t rng_ring[RNG_RING_SIZE];
+static volatile uint8_t rng_head = 0; //words put in by the interrupt
+static volatile uint8_t rng_tail = 0; //words taken out
 
 //configure TIM2
 void TIM2_init(void){
@@ -15,6 +24,22 @@ void TIM2_init(void){
 	NVIC->ISER[0] = (1 << TIM2_IRQn);
 }
 
+//start the DWT cycle counter used to time interrupt handlers
+void DWT_init(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+//count one run of a handler that started at cycle start
+void ISR_timing_end(IsrTiming *timing, uint32_t start) {
+	uint32_t cycles = DWT->CYCCNT - start;
+	timing->count++;
+	timing->cycles += cycles;
+	timing->worst = (cycles > timing->worst) ? cycles : timing->worst;
+	timing->last = cycles;
+}
+
 //configure LEDs to output, push-pull, very fast, no pull up/pull down resistor
 void LED_init(void) {
 	//turn on GPIOB and GPIOC clock
@@ -64,76 +89,41 @@ void RNG_init(void) {
     RCC->CCIPR |= RCC_CCIPR_CLK48SEL_0;
     //enable RNG clock
     RCC->AHB2ENR |= RCC_AHB2ENR_RNGEN;
-    //enable RNG
-    RNG->CR |= RNG_CR_RNGEN;
+    //enable RNG and its data ready interrupt, the ring fills in the background
+    RNG->CR |= (RNG_CR_RNGEN | RNG_CR_IE);
+    NVIC->ISER[2] |= (1 << (RNG_IRQn & NVIC_MASK));
 }
 
-//generate a random number
-uint32_t RNG_get_random_number(void) {
+//ISR for RNG, moves ready words into the ring
+void RNG_IRQHandler(void) {
 	//check for error bits
 	if (RNG->SR & (RNG_SR_SEIS | RNG_SR_CEIS)) {
-		//clear error bits
+		//clear error bits, a seed error also needs the RNG restarted
+		if (RNG->SR & RNG_SR_SEIS) {
+			RNG->CR &= ~RNG_CR_RNGEN;
+			RNG->CR |= RNG_CR_RNGEN;
+		}
 	    RNG->SR &= ~(RNG_SR_CEIS | RNG_SR_SEIS);
 	}
-    //wait for the data ready flag
-    while (!(RNG->SR & RNG_SR_DRDY));
-    //return the random number
-    return RNG->DR;
-}
-
-//calculate total balance based on number of chips
-uint32_t calculate_total_balance(Chips chips) {
-    uint32_t total_balance = (chips.yellow * YELLOW_VAL) +
-                             (chips.purple * PURPLE_VAL) +
-                             (chips.black * BLACK_VAL) +
-                             (chips.orange * ORANGE_VAL) +
-                             (chips.green * GREEN_VAL) +
-                             (chips.blue * BLUE_VAL) +
-                             (chips.red * RED_VAL) +
-                             (chips.white * WHITE_VAL);
-    return total_balance;
-}
-
-//determine odds/payout based on bet type
-uint32_t calculate_odds(const char *bet_type) {
-    if (strcmp(bet_type, "Straight") == 0) return 36;
-    if (strcmp(bet_type, "Split") == 0) return 18;
-    if (strcmp(bet_type, "Street") == 0) return 12;
-    if (strcmp(bet_type, "Basket") == 0) return 12;
-    if (strcmp(bet_type, "Corner") == 0) return 9;
-    if (strcmp(bet_type, "Top Line") == 0) return 7;
-    if (strcmp(bet_type, "Double Street") == 0) return 6;
-    if (strcmp(bet_type, "Dozen") == 0 || strcmp(bet_type, "Column") == 0) return 3;
-    if (strcmp(bet_type, "Red") == 0 || strcmp(bet_type, "Black") == 0 ||
-        strcmp(bet_type, "Odd") == 0 || strcmp(bet_type, "Even") == 0 ||
-        strcmp(bet_type, "Low") == 0 || strcmp(bet_type, "High") == 0) return 2;
-    return 0; //default odds
-}
-
-//distribute winnings into chips, starting with highest chip amount
-void distribute_chips(uint32_t amount, Chips *chips) {
-    uint32_t chip_values[] = {YELLOW_VAL, PURPLE_VAL, BLACK_VAL, ORANGE_VAL, GREEN_VAL, BLUE_VAL, RED_VAL, WHITE_VAL};
-    uint32_t *chip_counts[] = {&chips->yellow, &chips->purple, &chips->black, &chips->orange, &chips->green, &chips->blue, &chips->red, &chips->white};
-    //distribute through all chip values if possible
-    for (uint8_t i = 0; i < POSSIBLE_CHIPS; i++) {
-        while (amount >= chip_values[i]) {
-            (*chip_counts[i])++;
-            amount -= chip_values[i];
-        }
-    }
+	while ((RNG->SR & RNG_SR_DRDY) && (uint8_t)(rng_head - rng_tail) < RNG_RING_SIZE) {
+		rng_ring[rng_head & RNG_RING_MASK] = RNG->DR;
+		rng_head++;
+	}
+	//ring full, stop interrupting until a word is taken
+	if ((uint8_t)(rng_head - rng_tail) == RNG_RING_SIZE) {
+		RNG->CR &= ~RNG_CR_IE;
+	}
 }
 
-//validate and get chip pointer for a given chip value
-uint32_t* get_chip_pointer(uint32_t chip_value, Chips *chips) {
-    switch (chip_value) {
-        case YELLOW_VAL: return &chips->yellow;
-        case PURPLE_VAL: return &chips->purple;
-        case BLACK_VAL: return &chips->black;
-        case ORANGE_VAL: return &chips->orange;
-        case GREEN_VAL: return &chips->green;
-        case BLUE_VAL: return &chips->blue;
-        case RED_VAL: return &chips->red;
-        case WHITE_VAL: return &chips->white;
-        default: return NULL;
-    }
+//generate a random number
+uint32_t RNG_get_random_number(void) {
+	//wait for the interrupt only if the ring has run dry
+	while (rng_head == rng_tail) {
+		RNG->CR |= RNG_CR_IE;
+	}
+	uint32_t word = rng_ring[rng_tail & RNG_RING_MASK];
+	rng_tail++;
+	//room in the ring again, let the interrupt refill it
+	RNG->CR |= RNG_CR_IE;
+    return word;
 }
@@ -0,0 +1,34 @@
+#include "pacing.h"
+
+//show a spin ending at rest_step in duration_ms of wheel frames, at least PACING_MIN_FRAMES
+//the physics step shown at a fraction u of the frames is rest_step * (u + e * u * (1 - u)) with
+//e = ease / PACING_EASE_FULL, so the physics runs 1 + e times its even pace at the launch and
+//1 - e times it at the rest. ease is held to PACING_EASE_FULL, where the landing stops on screen
+void pacing_init(SpinPacing *pacing, uint32_t rest_step, uint32_t duration_ms, uint16_t ease) {
+    uint32_t frames = (uint32_t)(((uint64_t)duration_ms * PHYSICS_FRAME_HZ) / 1000);
+    pacing->rest_step = rest_step;
+    pacing->frames = (frames < PACING_MIN_FRAMES) ? PACING_MIN_FRAMES : frames;
+    pacing->ease = (ease < PACING_EASE_FULL) ? ease : PACING_EASE_FULL;
+}
+
+//physics step to draw at a frame, 0 at frame 0 and rest_step from the last frame on, never
+//going back from one frame to the next
+uint32_t pacing_step(const SpinPacing *pacing, uint32_t frame) {
+    uint32_t last = pacing->frames - 1;
+    if (frame >= last) {
+        return pacing->rest_step;
+    }
+    //rest_step * frame * (last * FULL + ease * (last - frame)) / (last^2 * FULL), which stays under
+    //rest_step for frames before the last
+    uint64_t bend = ((uint64_t)last * PACING_EASE_FULL) + ((uint64_t)pacing->ease * (last - frame));
+    uint64_t scale = (uint64_t)last * last * PACING_EASE_FULL;
+    return (uint32_t)(((uint64_t)pacing->rest_step * frame * bend) / scale);
+}
+
+//whether a frame should be drawn with backlog bytes still waiting to go out: a frame is dropped
+//while the bytes queued ahead of it would hold it back past budget bytes of wire time, as it
+//would only show late and delay the next. the last frame shows where the ball rests and is
+//always drawn
+bool pacing_draw(uint32_t backlog, uint32_t budget, bool last) {
+    return last || backlog <= budget;
+}
@@ -0,0 +1,21 @@
+#ifndef SRC_PACING_H_
+#define SRC_PACING_H_
+#include "physics.h"
+#include <stdbool.h>
+
+#define PACING_EASE_FULL 256 //ease of a spin that comes to a stop on screen, see pacing_init()
+#define PACING_MIN_FRAMES 2 //shortest spin, the launch and the rest
+
+//playback of a spin's physics over a set number of wheel frames, the physics timeline is warped
+//by an ease out curve so the fast start goes by quicker and the landing slower than they happen
+typedef struct {
+    uint32_t rest_step; //physics step of the last frame
+    uint32_t frames; //frames from launch to rest, the last one shows the rest
+    uint16_t ease; //bend of the curve, 0 plays the physics at an even pace
+} SpinPacing;
+
+void pacing_init(SpinPacing *, uint32_t, uint32_t, uint16_t);
+uint32_t pacing_step(const SpinPacing *, uint32_t);
+bool pacing_draw(uint32_t, uint32_t, bool);
+
+#endif
@@ -0,0 +1,37 @@
+//generated by Tools/payout_gen.c from the tables in spots.c, do not edit
+#ifndef SRC_PAYOUTS_H_
+#define SRC_PAYOUTS_H_
+#include "spots.h"
+
+//bet ID ranges of the wheel being built
+#if WHEEL_ZEROS == 1
+#include "payouts_single.h"
+#elif WHEEL_ZEROS == 2
+#include "payouts_double.h"
+#else
+#include "payouts_triple.h"
+#endif
+
+//node of the bet type name trie, node 0 is the root
+typedef struct {
+    char c; //character leading into the node
+    uint8_t first_child; //index of the first child, 0 if none
+    uint8_t next_sibling; //index of the next sibling, 0 if none
+    uint8_t bet_type; //bet type spelled by the path to this node, BET_TYPE_NONE if none
+    uint8_t completion; //only bet type below this node, BET_TYPE_NONE if several
+} BetTrieNode;
+
+//screen position of a spot on the table
+typedef struct {
+    uint8_t row; //screen row, 1 based
+    uint8_t col; //screen column of the first character of the label, 1 based
+} TableCell;
+
+extern const uint8_t payout_matrix[NUM_BET_IDS][ARR_SIZE];
+extern const PocketMask bet_pockets[NUM_BET_IDS];
+extern const uint8_t bet_type_first_id[NUM_BET_TYPES + 1];
+extern const BetTrieNode bet_type_trie[BET_TRIE_SIZE];
+extern const TableCell table_cells[ARR_SIZE];
+extern const Spot base_table_arr[ARR_SIZE];
+
+#endif
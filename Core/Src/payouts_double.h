@@ -0,0 +1,23 @@
+//generated by Tools/payout_gen.c from the tables in spots.c (double zero wheel), do not edit
+#ifndef SRC_PAYOUTS_DOUBLE_H_
+#define SRC_PAYOUTS_DOUBLE_H_
+
+#define BET_ID_STRAIGHT 0 //first of 38 Straight bet(s)
+#define BET_ID_SPLIT 38 //first of 61 Split bet(s)
+#define BET_ID_STREET 99 //first of 12 Street bet(s)
+#define BET_ID_BASKET 111 //first of 3 Basket bet(s)
+#define BET_ID_CORNER 114 //first of 22 Corner bet(s)
+#define BET_ID_TOP_LINE 136 //first of 1 Top Line bet(s)
+#define BET_ID_DOUBLE_STREET 137 //first of 11 Double Street bet(s)
+#define BET_ID_DOZEN 148 //first of 3 Dozen bet(s)
+#define BET_ID_COLUMN 151 //first of 3 Column bet(s)
+#define BET_ID_RED 154 //first of 1 Red bet(s)
+#define BET_ID_BLACK 155 //first of 1 Black bet(s)
+#define BET_ID_ODD 156 //first of 1 Odd bet(s)
+#define BET_ID_EVEN 157 //first of 1 Even bet(s)
+#define BET_ID_LOW 158 //first of 1 Low bet(s)
+#define BET_ID_HIGH 159 //first of 1 High bet(s)
+#define NUM_BET_IDS 160 //total bet IDs
+#define BET_TRIE_SIZE 77 //nodes in the bet type name trie
+
+#endif
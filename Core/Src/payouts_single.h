@@ -0,0 +1,23 @@
+//generated by Tools/payout_gen.c from the tables in spots.c (single zero wheel), do not edit
+#ifndef SRC_PAYOUTS_SINGLE_H_
+#define SRC_PAYOUTS_SINGLE_H_
+
+#define BET_ID_STRAIGHT 0 //first of 37 Straight bet(s)
+#define BET_ID_SPLIT 37 //first of 60 Split bet(s)
+#define BET_ID_STREET 97 //first of 12 Street bet(s)
+#define BET_ID_BASKET 109 //first of 2 Basket bet(s)
+#define BET_ID_CORNER 111 //first of 22 Corner bet(s)
+#define BET_ID_TOP_LINE 133 //first of 1 Top Line bet(s)
+#define BET_ID_DOUBLE_STREET 134 //first of 11 Double Street bet(s)
+#define BET_ID_DOZEN 145 //first of 3 Dozen bet(s)
+#define BET_ID_COLUMN 148 //first of 3 Column bet(s)
+#define BET_ID_RED 151 //first of 1 Red bet(s)
+#define BET_ID_BLACK 152 //first of 1 Black bet(s)
+#define BET_ID_ODD 153 //first of 1 Odd bet(s)
+#define BET_ID_EVEN 154 //first of 1 Even bet(s)
+#define BET_ID_LOW 155 //first of 1 Low bet(s)
+#define BET_ID_HIGH 156 //first of 1 High bet(s)
+#define NUM_BET_IDS 157 //total bet IDs
+#define BET_TRIE_SIZE 77 //nodes in the bet type name trie
+
+#endif
@@ -0,0 +1,164 @@
+#include "physics.h"
+#include <stdbool.h>
+
+#define DROP_HOP 8 //steps checked at a time while looking for the drop
+
+//wheel and dealer on the device, a 2.0-2.6 turn/s launch leaves the track after about 8 s
+const WheelPhysics wheel_physics = {
+    .ball_speed_min = TURNS_PER_S(2.0),
+    .ball_speed_max = TURNS_PER_S(2.6),
+    .ball_decel = TURNS_PER_S2(0.2),
+    .drop_speed = TURNS_PER_S(0.75),
+    .tilt = 0,
+    .tilt_angle = 0,
+    .rotor_speed = TURNS_PER_S(0.4),
+    .rotor_spread = TURNS_PER_S(0.05),
+    .rotor_decel = TURNS_PER_S2(0.004),
+    .launch_spread = 65536,
+    .fall_steps = STEPS(0.6),
+    .fall_decel = TURNS_PER_S2(0.5),
+    .deflector_chance = CHANCE(0.6),
+    .deflector_bias = 0,
+    .deflector_kick = TURNS(30.0 / 360),
+    .bounce_steps = STEPS(1.5),
+    .scatter_mean = 6,
+    .scatter_spread = 14,
+};
+
+//cosine of an angle in Q16, two parabolas, within 6% of the true cosine
+static int32_t cos_q16(uint32_t angle) {
+    uint32_t half_turns = (angle < 0x80000000u ? angle : -angle) >> 15; //distance from 0, 65536 is half a turn
+    if (half_turns <= 32768) {
+        return 65536 - (int32_t)((half_turns * half_turns) >> 14);
+    }
+    uint32_t from_half = 65536 - half_turns;
+    return (int32_t)((from_half * from_half) >> 14) - 65536;
+}
+
+//word scaled to [0, range)
+static uint32_t scale(uint32_t word, uint32_t range) {
+    return (uint32_t)(((uint64_t)word * range) >> 32);
+}
+
+//wheel index under an angle of the ball against the rotor
+static uint8_t index_of(uint32_t offset) {
+    return (uint8_t)(((uint64_t)offset * ARR_SIZE) >> 32);
+}
+
+//angle of the ball against the rotor in the middle of a wheel index
+static uint32_t pocket_middle(uint8_t index) {
+    return (uint32_t)((((uint64_t)(2 * index + 1)) << 32) / (2 * ARR_SIZE));
+}
+
+//distance travelled after n steps from speed, losing decel every step
+static uint32_t travel(int32_t speed, int32_t decel, uint32_t n) {
+    return (uint32_t)(((int64_t)speed * n) - ((int64_t)decel * n * (n + 1) / 2));
+}
+
+//rotor angle after n steps, the rotor turns backwards so friction adds to its speed
+static uint32_t rotor_angle_at(const WheelSpin *spin, uint32_t n) {
+    return spin->rotor_angle + travel(spin->rotor_speed, -spin->rotor_decel, n);
+}
+
+//ball angle after n steps, on the track up to the drop and falling after it
+static uint32_t ball_angle_at(const WheelSpin *spin, uint32_t n) {
+    if (n <= spin->drop_step) {
+        return spin->ball_angle + travel(spin->ball_speed, spin->ball_decel, n);
+    }
+    uint32_t falling = n - spin->drop_step;
+    uint32_t fall_steps = spin->contact_step - spin->drop_step;
+    uint32_t kick = (falling >= fall_steps / 2) ? spin->kick : 0; //deflector is struck halfway down
+    return spin->drop_angle + travel(spin->drop_speed, spin->fall_decel, falling) + kick;
+}
+
+//whether the ball has left the track by step n, it drops early on the low side of a tilted wheel
+static bool dropped(const WheelSpin *spin, const WheelPhysics *model, uint32_t n) {
+    int32_t speed = spin->ball_speed - (spin->ball_decel * (int32_t)n);
+    int32_t threshold = model->drop_speed + (int32_t)(((int64_t)model->tilt * cos_q16(ball_angle_at(spin, n) - model->tilt_angle)) >> 16);
+    return speed < threshold;
+}
+
+//signed travel of the bounce from the contact to the rest offset, the wrap nearest scatter pockets
+static int64_t bounce_travel(const WheelSpin *spin) {
+    int64_t distance = (uint32_t)(spin->rest_offset - spin->contact_offset);
+    int64_t expected = ((int64_t)spin->scatter << 32) / ARR_SIZE;
+    return (distance - expected > 0x80000000ll) ? distance - 0x100000000ll : distance;
+}
+
+//work out every event of a spin from its model and PHYSICS_WORDS random words
+//the ball speed, launch angle, rotor angle and speed, deflector and bounce each take one word,
+//so a spin depends only on its words and the device and host agree on every step of it
+void physics_launch(WheelSpin *spin, const WheelPhysics *model, const uint32_t words[PHYSICS_WORDS]) {
+    spin->ball_speed = model->ball_speed_min + (int32_t)scale(words[0], model->ball_speed_max - model->ball_speed_min);
+    spin->ball_angle = words[1];
+    spin->rotor_angle = words[1] + (uint32_t)(((uint64_t)words[2] * model->launch_spread) >> 16);
+    spin->rotor_speed = -(model->rotor_speed - model->rotor_spread + (int32_t)scale(words[3], 2 * model->rotor_spread));
+    spin->ball_decel = model->ball_decel;
+    spin->rotor_decel = model->rotor_decel;
+    spin->fall_decel = model->fall_decel;
+    spin->drop_step = UINT32_MAX; //on the track until the drop is found
+
+    //no drop while the ball is faster than the highest threshold, skip straight past that,
+    //then look DROP_HOP steps at a time and settle on the first step of that hop under the threshold
+    int32_t highest = model->drop_speed + ((model->tilt < 0) ? -model->tilt : model->tilt);
+    uint32_t step = (spin->ball_speed > highest) ? (uint32_t)((spin->ball_speed - highest) / spin->ball_decel) + 1 : 1;
+    while (!dropped(spin, model, step + DROP_HOP - 1)) {
+        step += DROP_HOP;
+    }
+    while (!dropped(spin, model, step)) {
+        step++;
+    }
+    spin->drop_step = step;
+    spin->drop_angle = ball_angle_at(spin, step);
+    spin->drop_speed = spin->ball_speed - (spin->ball_decel * (int32_t)step);
+    spin->drop_index = index_of(spin->drop_angle - rotor_angle_at(spin, step));
+    spin->contact_step = step + model->fall_steps;
+    spin->rest_step = spin->contact_step + model->bounce_steps;
+
+    //on the way down the ball passes the deflector nearest its halfway point, which may throw it
+    uint32_t halfway = spin->drop_angle + travel(spin->drop_speed, spin->fall_decel, model->fall_steps / 2);
+    uint8_t deflector = (uint8_t)((halfway + (0x80000000u / NUM_DEFLECTORS)) / (0x100000000ull / NUM_DEFLECTORS)) % NUM_DEFLECTORS;
+    uint32_t chance = model->deflector_chance + ((deflector == 0) ? model->deflector_bias : 0);
+    spin->kick = 0;
+    spin->deflector = NO_DEFLECTOR;
+    if ((words[4] & 0xFFFF) < chance) {
+        spin->deflector = deflector;
+        spin->kick = (uint32_t)(((int64_t)((int32_t)(words[4] >> 16) - 32768) * model->deflector_kick) >> 15);
+    }
+    uint32_t contact_step = spin->contact_step;
+    spin->contact_offset = ball_angle_at(spin, contact_step) - rotor_angle_at(spin, contact_step);
+
+    //bounces are the sum of two uniform halves of the last word, so the middle is most likely
+    uint32_t sum = (words[5] & 0xFFFF) + (words[5] >> 16);
+    spin->scatter = (int8_t)(model->scatter_mean - model->scatter_spread + (int32_t)((sum * (2u * model->scatter_spread + 1)) >> 17));
+    int16_t landing = (int16_t)((index_of(spin->contact_offset) + spin->scatter) % ARR_SIZE);
+    spin->landing_index = (uint8_t)((landing < 0) ? landing + ARR_SIZE : landing);
+    spin->rest_offset = pocket_middle(spin->landing_index);
+}
+
+//turn the rotor at launch so the ball comes to rest in a wheel index, the ball path stays the same
+//the device draws the winning index first and fits the spin to it, so the physics never changes the odds
+void physics_land_on(WheelSpin *spin, uint8_t index) {
+    int16_t contact = (int16_t)((index - spin->scatter) % ARR_SIZE);
+    uint32_t middle = pocket_middle((uint8_t)((contact < 0) ? contact + ARR_SIZE : contact));
+    spin->rotor_angle += spin->contact_offset - middle;
+    spin->contact_offset = middle;
+    spin->landing_index = index;
+    spin->rest_offset = pocket_middle(index);
+    spin->drop_index = index_of(spin->drop_angle - rotor_angle_at(spin, spin->drop_step));
+}
+
+//wheel index under the ball after a number of steps
+uint8_t physics_index_at(const WheelSpin *spin, uint32_t step) {
+    if (step >= spin->rest_step) {
+        return spin->landing_index;
+    }
+    if (step >= spin->contact_step) {
+        //bounce slows to a stop, it has covered 1 - (left / bounce)^2 of the way
+        int64_t bounce = spin->rest_step - spin->contact_step;
+        int64_t left = spin->rest_step - step;
+        int64_t covered = bounce_travel(spin) * ((bounce * bounce) - (left * left)) / (bounce * bounce);
+        return index_of(spin->contact_offset + (uint32_t)covered);
+    }
+    return index_of(ball_angle_at(spin, step) - rotor_angle_at(spin, step));
+}
@@ -0,0 +1,71 @@
+#ifndef SRC_PHYSICS_H_
+#define SRC_PHYSICS_H_
+#include "spots.h"
+
+#define PHYSICS_FRAME_HZ 38 //wheel frames per second (TIM2 update rate)
+#define PHYSICS_STEPS_PER_FRAME 8 //physics steps per wheel frame
+#define PHYSICS_STEP_HZ (PHYSICS_FRAME_HZ * PHYSICS_STEPS_PER_FRAME) //physics steps per second
+#define PHYSICS_WORDS 6 //random words drawn per spin
+#define NUM_DEFLECTORS 8 //deflectors on the stator, evenly spaced from angle 0
+#define NO_DEFLECTOR 0xFF //the ball reached the pockets without striking a deflector
+
+//angles are fractions of a turn in a uint32_t (2^32 is one revolution) so they wrap for free,
+//speeds are angle per step and decelerations speed per step
+#define TURNS(turns) ((uint32_t)((turns) * 4294967296.0))
+#define TURNS_PER_S(turns) ((int32_t)((turns) * 4294967296.0 / PHYSICS_STEP_HZ))
+#define TURNS_PER_S2(turns) ((int32_t)((turns) * 4294967296.0 / ((double)PHYSICS_STEP_HZ * PHYSICS_STEP_HZ)))
+#define STEPS(seconds) ((uint32_t)((seconds) * PHYSICS_STEP_HZ))
+#define CHANCE(fraction) ((uint32_t)((fraction) * 65536.0)) //probability out of 65536
+
+//wheel and dealer model, every field is fixed point so the device needs no floating point
+typedef struct {
+    int32_t ball_speed_min; //launch speed of the ball on the track
+    int32_t ball_speed_max;
+    int32_t ball_decel; //track friction on the ball
+    int32_t drop_speed; //the ball leaves the track below this speed on a level wheel
+    int32_t tilt; //drop speed added on the low side of the wheel, taken off the high side
+    uint32_t tilt_angle; //stator angle of the low side
+    int32_t rotor_speed; //rotor speed, against the ball
+    int32_t rotor_spread; //rotor speed varies by up to this either way
+    int32_t rotor_decel; //bearing friction on the rotor
+    uint32_t launch_spread; //spread of the rotor angle against the ball at launch, TURNS(1) for any
+    uint32_t fall_steps; //steps from leaving the track to reaching the pockets
+    int32_t fall_decel; //friction on the ball while it falls
+    uint32_t deflector_chance; //chance of striking a deflector on the way down
+    uint32_t deflector_bias; //extra chance of striking deflector 0
+    uint32_t deflector_kick; //largest angle a deflector throws the ball either way
+    uint32_t bounce_steps; //steps from reaching the pockets to coming to rest
+    int8_t scatter_mean; //pockets the ball bounces on average, forward against the rotor
+    uint8_t scatter_spread; //bounces vary by up to this many pockets either way
+} WheelPhysics;
+
+//one spin, every event fixed at launch so any step can be drawn without replaying the ones before
+typedef struct {
+    uint32_t ball_angle; //ball at launch, stator frame
+    uint32_t rotor_angle; //rotor at launch, stator frame
+    int32_t ball_speed; //ball at launch
+    int32_t rotor_speed; //rotor at launch, negative (the rotor turns against the ball)
+    int32_t ball_decel; //copied from the model so a spin stands alone
+    int32_t rotor_decel;
+    int32_t fall_decel;
+    uint32_t drop_step; //step the ball leaves the track
+    uint32_t contact_step; //step the ball reaches the pockets
+    uint32_t rest_step; //step the ball comes to rest
+    uint32_t drop_angle; //stator angle where the ball leaves the track
+    int32_t drop_speed; //ball speed as it leaves the track
+    uint32_t kick; //angle added by a deflector strike
+    uint32_t contact_offset; //ball minus rotor angle as the ball reaches the pockets
+    uint32_t rest_offset; //ball minus rotor angle at rest, the middle of the landing pocket
+    uint8_t deflector; //deflector struck, NO_DEFLECTOR if none
+    uint8_t drop_index; //wheel index under the ball as it leaves the track
+    uint8_t landing_index; //wheel index the ball comes to rest in
+    int8_t scatter; //pockets bounced from the contact pocket to the landing pocket
+} WheelSpin;
+
+extern const WheelPhysics wheel_physics;
+
+void physics_launch(WheelSpin *, const WheelPhysics *, const uint32_t[PHYSICS_WORDS]);
+void physics_land_on(WheelSpin *, uint8_t);
+uint8_t physics_index_at(const WheelSpin *, uint32_t);
+
+#endif
@@ -0,0 +1,18 @@
+#include "random.h"
+
+//random number in [0, bound) with no modulo bias (Lemire's multiply-shift with rejection)
+//the result is the high word of word * bound, the low word shows whether the word is one of
+//the 2^32 % bound that would make some results more likely. that can only happen when the
+//low word is under bound, so the division that finds the exact threshold almost never runs
+uint32_t RNG_get_random_below(uint32_t bound) {
+    uint64_t product = (uint64_t)RNG_get_random_number() * bound;
+    uint32_t low = (uint32_t)product;
+    if (low < bound) {
+        uint32_t threshold = -bound % bound; //2^32 % bound
+        while (low < threshold) {
+            product = (uint64_t)RNG_get_random_number() * bound;
+            low = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
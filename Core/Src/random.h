@@ -0,0 +1,8 @@
+#ifndef SRC_RANDOM_H_
+#define SRC_RANDOM_H_
+#include <stdint.h>
+
+uint32_t RNG_get_random_number(void);
+uint32_t RNG_get_random_below(uint32_t);
+
+#endif
@@ -0,0 +1,303 @@
+#include "screen.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define ESC "\x1B"
+#define RESET_CODE ESC "[0m"
+#define TAB_STOP 8 //columns between terminal tab stops
+#define OUT_SIZE 64 //bytes gathered before they are written
+#define ROW_BIT(row) ((uint64_t)1 << (row))
+
+//select graphic rendition parameter of each foreground color, indexed by ScreenColor, the
+//default comes from a reset
+static const char *color_params[] = {"", "32", "31", "30", "33", "35", "38:5:202", "34", "96"};
+
+//bytes of a flush on their way to the terminal
+typedef struct {
+    ScreenWriteFn write;
+    uint32_t length;
+    char data[OUT_SIZE];
+} ScreenOut;
+
+static void out_flush(ScreenOut *out) {
+    if (out->length > 0) {
+        out->write(out->data, out->length);
+        out->length = 0;
+    }
+}
+
+static void out_bytes(ScreenOut *out, const char *data, uint32_t length) {
+    if (out->length + length > OUT_SIZE) {
+        out_flush(out);
+    }
+    memcpy(&out->data[out->length], data, length);
+    out->length += length;
+}
+
+static void out_string(ScreenOut *out, const char *text) {
+    out_bytes(out, text, strlen(text));
+}
+
+//decimal digits of a screen position or distance
+static uint8_t digits(uint8_t value) {
+    return (value < 10) ? 1 : (value < 100) ? 2 : 3;
+}
+
+static void out_number(ScreenOut *out, uint8_t value) {
+    char text[3];
+    uint8_t length = digits(value);
+    for (uint8_t i = length; i > 0; i--) {
+        text[i - 1] = (char)('0' + (value % 10));
+        value /= 10;
+    }
+    out_bytes(out, text, length);
+}
+
+//a space looks the same in any color, only an underline shows
+static bool blank(ScreenCell cell) {
+    return cell.ch == ' ' && !(cell.attr & ATTR_UNDERLINE);
+}
+
+static bool same_cell(ScreenCell a, ScreenCell b) {
+    return (a.ch == b.ch && a.attr == b.attr) || (blank(a) && blank(b));
+}
+
+//the cell comes out right when written with the terminal attributes as they are
+static bool fits_attr(ScreenCell cell, uint8_t attr) {
+    return cell.attr == attr || (blank(cell) && !(attr & ATTR_UNDERLINE));
+}
+
+//change the terminal attributes in one escape code, styles only turn off with a reset that
+//drops the color too
+static void set_attr(Screen *screen, ScreenOut *out, uint8_t attr) {
+    uint8_t styles = ATTR_BOLD | ATTR_UNDERLINE;
+    const char *params[4];
+    uint8_t count = 0;
+    if ((screen->attr & ~attr & styles)
+        || ((attr & ATTR_COLOR) == COLOR_DEFAULT && (screen->attr & ATTR_COLOR) != COLOR_DEFAULT)) {
+        params[count++] = "0";
+        screen->attr = 0;
+    }
+    if ((attr & ATTR_BOLD) && !(screen->attr & ATTR_BOLD)) {
+        params[count++] = "1";
+    }
+    if ((attr & ATTR_UNDERLINE) && !(screen->attr & ATTR_UNDERLINE)) {
+        params[count++] = "4";
+    }
+    if ((attr & ATTR_COLOR) != (screen->attr & ATTR_COLOR)) {
+        params[count++] = color_params[attr & ATTR_COLOR];
+    }
+    out_string(out, ESC "[");
+    for (uint8_t i = 0; i < count; i++) {
+        out_string(out, (i > 0) ? ";" : "");
+        out_string(out, params[i]);
+    }
+    out_string(out, "m");
+    screen->attr = attr;
+}
+
+//move the terminal cursor to a 0 based cell by the shortest way: along the row by writing the
+//cells in between over again when they are shorter than a move right, else a move right, else
+//an absolute move
+static void move_to(Screen *screen, ScreenOut *out, uint8_t row, uint8_t col) {
+    if (screen->row == row && screen->col <= col) {
+        uint8_t gap = col - screen->col;
+        bool write_over = gap < 3 + digits(gap);
+        for (uint8_t c = screen->col; c < col && write_over; c++) {
+            write_over = fits_attr(screen->cells[row][c], screen->attr);
+        }
+        if (write_over) {
+            for (uint8_t c = screen->col; c < col; c++) {
+                out_bytes(out, &screen->cells[row][c].ch, 1);
+            }
+        } else {
+            out_string(out, ESC "[");
+            out_number(out, gap);
+            out_string(out, "C");
+        }
+    } else {
+        out_string(out, ESC "[");
+        out_number(out, row + 1);
+        if (col > 0) {
+            out_string(out, ";");
+            out_number(out, col + 1);
+        }
+        out_string(out, "H");
+    }
+    screen->row = row;
+    screen->col = col;
+}
+
+//clear the run of blank cells from the cursor with one erase when that is shorter than writing
+//the changed ones, to the end of the line (EL) if the run gets there or else a count of
+//characters (ECH) and a move right over them. neither moves the cursor
+static bool erase_blanks(Screen *screen, ScreenOut *out, uint8_t row, uint8_t col) {
+    uint8_t end = col;
+    uint8_t changed = 0;
+    while (end < SCREEN_COLS && blank(screen->cells[row][end])) {
+        changed += same_cell(screen->cells[row][end], screen->shown[row][end]) ? 0 : 1;
+        end++;
+    }
+    uint8_t length = end - col;
+    bool to_end = (end == SCREEN_COLS);
+    //erased cells take no underline, so the attributes do not matter
+    uint8_t cost = to_end ? 3 : 3 + digits(length) + 3 + digits(length);
+    if (changed <= cost) {
+        return false;
+    }
+    if (to_end) {
+        out_string(out, ESC "[K");
+    } else {
+        out_string(out, ESC "[");
+        out_number(out, length);
+        out_string(out, "X");
+    }
+    for (uint8_t c = col; c < end; c++) {
+        screen->shown[row][c] = screen->cells[row][c];
+    }
+    return true;
+}
+
+//start with the terminal and the drawing blank, as after a clear screen
+void screen_init(Screen *screen) {
+    for (uint8_t row = 0; row < SCREEN_ROWS; row++) {
+        for (uint8_t col = 0; col < SCREEN_COLS; col++) {
+            screen->cells[row][col] = (ScreenCell){' ', 0};
+            screen->shown[row][col] = (ScreenCell){' ', 0};
+        }
+    }
+    screen->dirty = 0;
+    screen->row = SCREEN_ROWS;
+    screen->col = 0;
+    screen->attr = 0;
+}
+
+//draw text from a 1 based row and column, cut at the right edge
+//tabs move on to the next tab stop over the cells between, as on the terminal
+void screen_put(Screen *screen, uint8_t row, uint8_t col, const char *text, uint8_t attr) {
+    if (row < 1 || row > SCREEN_ROWS || col < 1) {
+        return;
+    }
+    ScreenCell *line = screen->cells[row - 1];
+    for (uint8_t c = col - 1; *text != '\0' && c < SCREEN_COLS; text++) {
+        if (*text == '\t') {
+            c = ((c / TAB_STOP) + 1) * TAB_STOP;
+            continue;
+        }
+        line[c] = (ScreenCell){*text, attr};
+        c++;
+    }
+    screen->dirty |= ROW_BIT(row - 1);
+}
+
+//draw count copies of a character from a 1 based row and column
+void screen_fill(Screen *screen, uint8_t row, uint8_t col, uint8_t count, char ch, uint8_t attr) {
+    if (row < 1 || row > SCREEN_ROWS || col < 1) {
+        return;
+    }
+    ScreenCell *line = screen->cells[row - 1];
+    for (uint8_t c = col - 1; count > 0 && c < SCREEN_COLS; c++, count--) {
+        line[c] = (ScreenCell){ch, attr};
+    }
+    screen->dirty |= ROW_BIT(row - 1);
+}
+
+//send the cells of a 0 based row that differ from the terminal
+static void flush_row(Screen *screen, ScreenOut *out, uint8_t row) {
+    for (uint8_t col = 0; col < SCREEN_COLS; col++) {
+        ScreenCell cell = screen->cells[row][col];
+        if (same_cell(cell, screen->shown[row][col])) {
+            continue;
+        }
+        move_to(screen, out, row, col);
+        if (blank(cell) && erase_blanks(screen, out, row, col)) {
+            //the cursor stays put, the loop goes on after the erased cells
+            while (col + 1 < SCREEN_COLS && blank(screen->cells[row][col + 1])) {
+                col++;
+            }
+            continue;
+        }
+        if (!fits_attr(cell, screen->attr)) {
+            set_attr(screen, out, cell.attr);
+        }
+        out_bytes(out, &cell.ch, 1);
+        screen->shown[row][col] = cell;
+        screen->col++;
+    }
+    //a terminal as wide as the screen holds the cursor on the last column until the next
+    //character wraps it, so a move along the row from there is not safe
+    screen->row = (screen->col < SCREEN_COLS) ? screen->row : SCREEN_ROWS;
+    screen->dirty &= ~ROW_BIT(row);
+}
+
+//the cursor is not known at the start of a flush, as anything may have been printed since
+static void flush_begin(Screen *screen) {
+    screen->row = SCREEN_ROWS;
+    screen->attr = 0;
+}
+
+//leave the attributes reset for whatever is printed next
+static void flush_end(Screen *screen, ScreenOut *out) {
+    if (screen->attr != 0) {
+        out_string(out, RESET_CODE);
+        screen->attr = 0;
+    }
+    out_flush(out);
+}
+
+//send what was drawn since the last flush and differs from the terminal
+void screen_flush(Screen *screen, ScreenWriteFn write) {
+    ScreenOut out = {write, 0, {0}};
+    flush_begin(screen);
+    for (uint8_t row = 0; row < SCREEN_ROWS; row++) {
+        if (screen->dirty & ROW_BIT(row)) {
+            flush_row(screen, &out, row);
+        }
+    }
+    flush_end(screen, &out);
+}
+
+//send one 1 based row the same way, at most SCREEN_ROW_BYTES
+void screen_flush_row(Screen *screen, uint8_t row, ScreenWriteFn write) {
+    ScreenOut out = {write, 0, {0}};
+    if (row < 1 || row > SCREEN_ROWS) {
+        return;
+    }
+    flush_begin(screen);
+    flush_row(screen, &out, row - 1);
+    flush_end(screen, &out);
+}
+
+//first 1 based row drawn since it was last flushed, 0 when there is none
+uint8_t screen_dirty_row(const Screen *screen) {
+    for (uint8_t row = 0; row < SCREEN_ROWS; row++) {
+        if (screen->dirty & ROW_BIT(row)) {
+            return row + 1;
+        }
+    }
+    return 0;
+}
+
+//unpack count bytes of a packed stream into every stride-th byte from dest, returns the stream
+//after them
+static const uint8_t *unpack(const uint8_t *packed, uint8_t *dest, uint32_t stride, uint32_t count) {
+    while (count > 0) {
+        uint8_t control = *packed++;
+        uint32_t length = (control < SCREEN_PACK_REPEAT) ? control + 1u : control - SCREEN_PACK_REPEAT + 3u;
+        length = (length < count) ? length : count;
+        for (uint32_t i = 0; i < length; i++) {
+            *dest = (control < SCREEN_PACK_REPEAT) ? packed[i] : *packed;
+            dest += stride;
+        }
+        packed += (control < SCREEN_PACK_REPEAT) ? length : 1;
+        count -= length;
+    }
+    return packed;
+}
+
+//draw every cell from a packed screen (see screen.h)
+void screen_load(Screen *screen, const uint8_t *packed) {
+    packed = unpack(packed, (uint8_t *)&screen->cells[0][0].ch, sizeof(ScreenCell), SCREEN_ROWS * SCREEN_COLS);
+    unpack(packed, &screen->cells[0][0].attr, sizeof(ScreenCell), SCREEN_ROWS * SCREEN_COLS);
+    screen->dirty = ROW_BIT(SCREEN_ROWS) - 1;
+}
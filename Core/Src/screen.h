@@ -0,0 +1,66 @@
+#ifndef SRC_SCREEN_H_
+#define SRC_SCREEN_H_
+#include <stdint.h>
+
+#define SCREEN_ROWS 37 //terminal rows the game draws, the prompt line is row 36 between two rules
+#define SCREEN_COLS 70 //terminal columns the game draws
+
+//most bytes a flush of one row can take: a move, then every cell behind the longest change
+//of attributes, then a reset
+#define SCREEN_ROW_BYTES (8 + (SCREEN_COLS * 18) + 4)
+
+//packed screens, a byte n under SCREEN_PACK_REPEAT is followed by n + 1 bytes as they are and
+//one from it by a single byte repeated n - SCREEN_PACK_REPEAT + 3 times. the characters of
+//every cell row by row come first, then their attributes
+#define SCREEN_PACK_REPEAT 128
+
+//cell attributes, a color in the low bits and the styles above it
+#define ATTR_COLOR 0x0F //ScreenColor of the character
+#define ATTR_BOLD 0x10
+#define ATTR_UNDERLINE 0x20
+
+//foreground colors, indexes of their escape codes
+typedef enum {
+    COLOR_DEFAULT,
+    COLOR_GREEN,
+    COLOR_RED,
+    COLOR_BLACK,
+    COLOR_YELLOW,
+    COLOR_PURPLE,
+    COLOR_ORANGE,
+    COLOR_BLUE,
+    COLOR_CYAN
+} ScreenColor;
+
+//one character position of the terminal
+typedef struct {
+    char ch; //character shown
+    uint8_t attr; //ScreenColor and styles it is shown in
+} ScreenCell;
+
+//sends bytes to the terminal
+typedef void (*ScreenWriteFn)(const char *data, uint32_t length);
+
+//shadow of the terminal, drawing only changes RAM and a flush sends the cells that differ from
+//what the terminal already shows, so a redraw costs bytes in proportion to what changed
+typedef struct {
+    ScreenCell cells[SCREEN_ROWS][SCREEN_COLS]; //what the game has drawn
+    ScreenCell shown[SCREEN_ROWS][SCREEN_COLS]; //what the terminal shows
+    uint64_t dirty; //rows drawn since the last flush, bit per row
+    uint8_t row; //terminal cursor during a flush, 0 based, SCREEN_ROWS when not known
+    uint8_t col;
+    uint8_t attr; //terminal attributes during a flush
+} Screen;
+
+void screen_init(Screen *);
+void screen_put(Screen *, uint8_t, uint8_t, const char *, uint8_t);
+void screen_fill(Screen *, uint8_t, uint8_t, uint8_t, char, uint8_t);
+void screen_flush(Screen *, ScreenWriteFn);
+void screen_flush_row(Screen *, uint8_t, ScreenWriteFn);
+uint8_t screen_dirty_row(const Screen *);
+void screen_load(Screen *, const uint8_t *);
+
+//start screen of the wheel variant, packed by Tools/screen_gen.c
+extern const uint8_t start_screen_packed[];
+
+#endif
@@ -1,32 +1,67 @@
 #include "spots.h"
 
-//base colored table spots
-const Spot base_table_arr[ARR_SIZE] = {
-	{"green", "00"}, {"green", " 0"}, {"red", " 3"}, {"black", " 6"}, {"red", " 9"},
-	{"red", "12"}, {"black", "15"}, {"red", "18"}, {"red", "21"}, {"black", "24"},
-	{"red", "27"}, {"red", "30"}, {"black", "33"}, {"red", "36"}, {"black", " 2"},
-	{"red", " 5"}, {"black", " 8"}, {"black", "11"}, {"red", "14"}, {"black", "17"},
-	{"black", "20"}, {"red", "23"}, {"black", "26"}, {"black", "29"}, {"red", "32"},
-	{"black", "35"}, {"red", " 1"}, {"black", " 4"}, {"red", " 7"}, {"black", "10"},
-	{"black", "13"}, {"red", "16"}, {"red", "19"}, {"black", "22"}, {"red", "25"},
-	{"black", "28"}, {"black", "31"}, {"red", "34"}
+//color of each pocket, indexed by pocket
+const uint8_t spot_colors[ARR_SIZE] = {
+	SPOT_GREEN, SPOT_RED, SPOT_BLACK, SPOT_RED, SPOT_BLACK, SPOT_RED,
+	SPOT_BLACK, SPOT_RED, SPOT_BLACK, SPOT_RED, SPOT_BLACK, SPOT_BLACK,
+	SPOT_RED, SPOT_BLACK, SPOT_RED, SPOT_BLACK, SPOT_RED, SPOT_BLACK,
+	SPOT_RED, SPOT_RED, SPOT_BLACK, SPOT_RED, SPOT_BLACK, SPOT_RED,
+	SPOT_BLACK, SPOT_RED, SPOT_BLACK, SPOT_RED, SPOT_BLACK, SPOT_BLACK,
+	SPOT_RED, SPOT_BLACK, SPOT_RED, SPOT_BLACK, SPOT_RED, SPOT_BLACK,
+	SPOT_RED,
+#if WHEEL_ZEROS >= 2
+	SPOT_GREEN,
+#endif
+#if WHEEL_ZEROS == 3
+	SPOT_GREEN
+#endif
+};
+
+//display text of each pocket, padded to two characters ("000" takes three)
+const char spot_labels[ARR_SIZE][4] = {
+	" 0", " 1", " 2", " 3", " 4", " 5", " 6", " 7", " 8", " 9", "10", "11", "12",
+	"13", "14", "15", "16", "17", "18", "19", "20", "21", "22", "23", "24", "25",
+	"26", "27", "28", "29", "30", "31", "32", "33", "34", "35", "36",
+#if WHEEL_ZEROS >= 2
+	"00",
+#endif
+#if WHEEL_ZEROS == 3
+	"000"
+#endif
 };
 
 //wheel spots
+#if WHEEL_ZEROS == 1
+const Spot wheel_arr[ARR_SIZE] = {
+	0, 32, 15, 19, 4, 21, 2, 25, 17, 34, 6, 27, 13,
+	36, 11, 30, 8, 23, 10, 5, 24, 16, 33, 1, 20, 14,
+	31, 9, 22, 18, 29, 7, 28, 12, 35, 3, 26
+};
+#elif WHEEL_ZEROS == 2
+const Spot wheel_arr[ARR_SIZE] = {
+	POCKET_00, 27, 10, 25, 29, 12, 8, 19, 31, 18, 6, 21, 33,
+	16, 4, 23, 35, 14, 2, 0, 28, 9, 26, 30, 11, 7,
+	20, 32, 17, 5, 22, 34, 15, 3, 24, 36, 13, 1
+};
+#else
+//the double zero order with 000 between 1 and 00
 const Spot wheel_arr[ARR_SIZE] = {
-	{"green", "00"}, {"red", "27"}, {"black", "10"}, {"red", "25"}, {"black", "29"},
-	{"red", "12"}, {"black", " 8"}, {"red", "19"}, {"black", "31"}, {"red", "18"},
-	{"black", " 6"}, {"red", "21"}, {"black", "33"}, {"red", "16"}, {"black", " 4"},
-	{"red", "23"}, {"black", "35"}, {"red", "14"}, {"black", " 2"}, {"green", " 0"},
-	{"black", "28"}, {"red", " 9"}, {"black", "26"}, {"red", "30"}, {"black", "11"},
-	{"red", " 7"}, {"black", "20"}, {"red", "32"}, {"black", "17"}, {"red", " 5"},
-	{"black", "22"}, {"red", "34"}, {"black", "15"}, {"red", " 3"}, {"black", "24"},
-	{"red", "36"}, {"black", "13"}, {"red", " 1"}
+	POCKET_00, 27, 10, 25, 29, 12, 8, 19, 31, 18, 6, 21, 33,
+	16, 4, 23, 35, 14, 2, 0, 28, 9, 26, 30, 11, 7,
+	20, 32, 17, 5, 22, 34, 15, 3, 24, 36, 13, 1, POCKET_000
 };
+#endif
 
-//possible split bets
+//possible split bets, the ones next to a zero first
 const char *split_bets[][SPLIT_SIZE] = {
-    {"0", "1"}, {"0", "2"}, {"00", "2"}, {"00", "3"}, {"1", "2"}, {"2", "3"},
+#if WHEEL_ZEROS == 1
+    {"0", "1"}, {"0", "2"}, {"0", "3"},
+#elif WHEEL_ZEROS == 2
+    {"0", "1"}, {"0", "2"}, {"00", "2"}, {"00", "3"},
+#else
+    {"0", "1"}, {"0", "000"}, {"000", "2"}, {"000", "00"}, {"00", "3"},
+#endif
+    {"1", "2"}, {"2", "3"},
     {"1", "4"}, {"2", "5"}, {"3", "6"}, {"4", "5"}, {"5", "6"}, {"4", "7"},
     {"5", "8"}, {"6", "9"}, {"7", "8"}, {"8", "9"}, {"7", "10"}, {"8", "11"},
     {"9", "12"}, {"10", "11"}, {"11", "12"}, {"10", "13"}, {"11", "14"}, {"12", "15"},
@@ -48,7 +83,13 @@ const char *street_bets[][ST_SIZE] = {
 
 //possible baskets
 const char *basket_bets[][BASKET_SIZE] = {
+#if WHEEL_ZEROS == 1
+    {"0", "1", "2"}, {"0", "2", "3"}
+#elif WHEEL_ZEROS == 2
     {"0", "1", "2"}, {"0", "00", "2"}, {"00", "2", "3"}
+#else
+    {"0", "000", "00"}
+#endif
 };
 
 //possible corners
@@ -63,7 +104,13 @@ const char *corner_bets[][CORNER_SIZE] = {
 };
 
 //top line
+#if WHEEL_ZEROS == 1
+const char *top_line[] = {"0", "1", "2", "3"};
+#elif WHEEL_ZEROS == 2
 const char *top_line[] = {"0", "00", "1", "2", "3"};
+#else
+const char *top_line[] = {"0", "000", "00", "1", "2", "3"};
+#endif
 
 //possible double streets
 const char *double_street_bets[][DUB_ST_SIZE] = {
@@ -124,3 +171,54 @@ const char *high_half[] = {
     "19", "20", "21", "22", "23", "24", "25", "26", "27", "28",
     "29", "30", "31", "32", "33", "34", "35", "36"
 };
+
+//convert spot text ("00", " 7", "7") to its pocket index
+uint8_t spot_to_pocket(const char *number) {
+    //skip padding used by the table/wheel arrays
+    while (*number == ' ') {
+        number++;
+    }
+#if WHEEL_ZEROS >= 2
+    if (number[0] == '0' && number[1] == '0' && number[2] == '\0') {
+        return POCKET_00;
+    }
+#endif
+#if WHEEL_ZEROS == 3
+    if (number[0] == '0' && number[1] == '0' && number[2] == '0' && number[3] == '\0') {
+        return POCKET_000;
+    }
+#endif
+    //accept one or two digits up to 36, a leading zero only on 0 itself so a zero pocket this
+    //wheel does not have ("00" on a single zero wheel) is not taken for 0
+    const char *first = number;
+    uint8_t pocket = 0;
+    uint8_t digits = 0;
+    while (*number >= '0' && *number <= '9' && digits < 2) {
+        pocket = (pocket * 10) + (*number - '0');
+        number++;
+        digits++;
+    }
+    if (digits == 0 || *number != '\0' || pocket > 36 || (digits == 2 && first[0] == '0')) {
+        return POCKET_INVALID;
+    }
+    return pocket;
+}
+
+//bet type names as typed at the terminal
+const char *bet_type_names[NUM_BET_TYPES] = {
+    "Straight", "Split", "Street", "Basket", "Corner", "Top Line", "Double Street",
+    "Dozen", "Column", "Red", "Black", "Odd", "Even", "Low", "High"
+};
+
+//payout multiplier (stake included) of each bet type, the top line pays 36 / its size
+static const uint8_t bet_type_odds[NUM_BET_TYPES] = {
+    36, 18, 12, 12, 9, 36 / TOP_LINE_SIZE, 6, 3, 3, 2, 2, 2, 2, 2, 2
+};
+
+//determine odds/payout based on bet type
+uint32_t calculate_odds(BetType bet_type) {
+    if (bet_type >= NUM_BET_TYPES) {
+        return 0; //default odds
+    }
+    return bet_type_odds[bet_type];
+}
@@ -1,23 +1,80 @@
 #ifndef SRC_SPOTS_H_
 #define SRC_SPOTS_H_
-#include "stm32l4xx_hal.h"
+#include <stdint.h>
 
-#define ARR_SIZE 38 //total spots
+//wheel variant, chosen at build time with -DWHEEL_ZEROS=1 (single zero), 2 (double zero)
+//or 3 (triple zero). every table, payout and screen position is fixed per variant, so a
+//build carries only its own tables and nothing branches on the variant at run time
+#ifndef WHEEL_ZEROS
+#define WHEEL_ZEROS 2 //American double zero wheel
+#endif
+#if WHEEL_ZEROS < 1 || WHEEL_ZEROS > 3
+#error "WHEEL_ZEROS must be 1, 2 or 3"
+#endif
+
+#define ARR_SIZE (36 + WHEEL_ZEROS) //total spots
 #define SPLIT_SIZE 2 //number of spots in a split
 #define ST_SIZE 3 //number of spots in a street
 #define BASKET_SIZE 3 //number of spots in a basket
 #define CORNER_SIZE 4 //number of spots in a corner
 #define DUB_ST_SIZE 6 //number of spots in a double street
 #define DOZ_COL_SIZE 12 //number of spots in a dozen/column
+#define TOP_LINE_SIZE (WHEEL_ZEROS + 3) //the zeros and the first street
+#define NUM_SPLITS (59 + WHEEL_ZEROS) //rows of split_bets, 57 between numbers and the rest next to a zero
+#define NUM_BASKETS (WHEEL_ZEROS == 1 ? 2 : WHEEL_ZEROS == 2 ? 3 : 1) //rows of basket_bets
+#define POCKET_00 37 //pocket index of "00" (0-36 map to themselves), double and triple zero only
+#define POCKET_000 38 //pocket index of "000", triple zero only
+#define POCKET_INVALID 0xFF //returned for text that is not a pocket
+
+#if WHEEL_ZEROS == 1
+#define WHEEL_NAME "single zero"
+#define POCKET_RANGE "0-36" //straight bet prompt
+#elif WHEEL_ZEROS == 2
+#define WHEEL_NAME "double zero"
+#define POCKET_RANGE "00-36"
+#else
+#define WHEEL_NAME "triple zero"
+#define POCKET_RANGE "000-36"
+#endif
 
-//structure to represent spot
-typedef struct {
-    char color[6]; //spot color
-    char number[3]; //spot number
-} Spot;
+//bet types, in the order their rows appear in the payout matrix
+typedef enum {
+    BET_STRAIGHT,
+    BET_SPLIT,
+    BET_STREET,
+    BET_BASKET,
+    BET_CORNER,
+    BET_TOP_LINE,
+    BET_DOUBLE_STREET,
+    BET_DOZEN,
+    BET_COLUMN,
+    BET_RED,
+    BET_BLACK,
+    BET_ODD,
+    BET_EVEN,
+    BET_LOW,
+    BET_HIGH,
+    NUM_BET_TYPES,
+    BET_TYPE_NONE = 0xFF //not a bet type
+} BetType;
 
+//bit mask of covered pockets, bit n is set when pocket n is covered
+typedef uint64_t PocketMask;
+#define POCKET_BIT(pocket) ((PocketMask)1 << (pocket))
+
+//spot colors
+typedef enum {
+    SPOT_GREEN,
+    SPOT_RED,
+    SPOT_BLACK
+} SpotColor;
+
+//spot identified by its pocket index (0-36, then POCKET_00 and POCKET_000 if the wheel has them)
+typedef uint8_t Spot;
+
+extern const uint8_t spot_colors[ARR_SIZE];
+extern const char spot_labels[ARR_SIZE][4];
 extern const Spot wheel_arr[ARR_SIZE];
-extern const Spot base_table_arr[ARR_SIZE];
 extern const char *split_bets[][SPLIT_SIZE];
 extern const char *street_bets[][ST_SIZE];
 extern const char *basket_bets[][BASKET_SIZE];
@@ -32,5 +89,9 @@ extern const char *odds[];
 extern const char *evens[];
 extern const char *low_half[];
 extern const char *high_half[];
+extern const char *bet_type_names[NUM_BET_TYPES];
+
+uint8_t spot_to_pocket(const char *);
+uint32_t calculate_odds(BetType);
 
 #endif
@@ -0,0 +1,77 @@
+//generated by Tools/screen_gen.c (triple zero wheel), do not edit
+#include "spots.h"
+#include "screen.h"
+
+#if WHEEL_ZEROS == 3
+
+//cells of the start screen packed for screen_load(), 956 bytes of characters then 71 of
+//attributes for 2590 cells
+const uint8_t start_screen_packed[1027] = {
+    0x9C, 0x20, 0x07, 0x52, 0x4F, 0x55, 0x4C, 0x45, 0x54, 0x54, 0x45, 0xFF, 0x20, 0xC7, 0x20, 0x81,
+    0x23, 0xAB, 0x20, 0x90, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x90, 0x2D, 0x9B, 0x20, 0x00,
+    0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00,
+    0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x9B, 0x20, 0x90,
+    0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x90, 0x2D, 0xFF, 0x20, 0x97, 0x20, 0xBA, 0x2D, 0x86,
+    0x20, 0x00, 0x7C, 0x89, 0x20, 0x05, 0x31, 0x20, 0x2D, 0x20, 0x31, 0x38, 0x88, 0x20, 0x00, 0x7C,
+    0x88, 0x20, 0x06, 0x31, 0x39, 0x20, 0x2D, 0x20, 0x33, 0x36, 0x88, 0x20, 0x00, 0x7C, 0x83, 0x20,
+    0x80, 0x2D, 0x00, 0x7C, 0x9A, 0x2D, 0x00, 0x7C, 0x9A, 0x2D, 0x00, 0x7C, 0x83, 0x2D, 0x03, 0x7C,
+    0x20, 0x20, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81,
+    0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81,
+    0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81,
+    0x20, 0x0A, 0x7C, 0x20, 0x33, 0x72, 0x64, 0x20, 0x7C, 0x7C, 0x2D, 0x2D, 0x7C, 0x81, 0x2D, 0x00,
+    0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00,
+    0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00,
+    0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x82, 0x2D, 0x04,
+    0x7C, 0x7C, 0x20, 0x20, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00,
+    0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00,
+    0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00,
+    0x7C, 0x81, 0x20, 0x0A, 0x7C, 0x20, 0x32, 0x6E, 0x64, 0x20, 0x7C, 0x7C, 0x2D, 0x2D, 0x7C, 0x81,
+    0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81,
+    0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81,
+    0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x81, 0x2D, 0x00, 0x7C, 0x82,
+    0x2D, 0x04, 0x7C, 0x7C, 0x20, 0x20, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81,
+    0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81,
+    0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x00, 0x7C, 0x81,
+    0x20, 0x00, 0x7C, 0x81, 0x20, 0x06, 0x7C, 0x20, 0x31, 0x73, 0x74, 0x20, 0x7C, 0x80, 0x2D, 0x00,
+    0x7C, 0x90, 0x2D, 0x00, 0x7C, 0x90, 0x2D, 0x00, 0x7C, 0x90, 0x2D, 0x00, 0x7C, 0x83, 0x2D, 0x80,
+    0x20, 0x00, 0x7C, 0x84, 0x20, 0x05, 0x31, 0x20, 0x2D, 0x20, 0x31, 0x32, 0x83, 0x20, 0x00, 0x7C,
+    0x83, 0x20, 0x06, 0x31, 0x33, 0x20, 0x2D, 0x20, 0x32, 0x34, 0x83, 0x20, 0x00, 0x7C, 0x83, 0x20,
+    0x06, 0x32, 0x35, 0x20, 0x2D, 0x20, 0x33, 0x36, 0x83, 0x20, 0x00, 0x7C, 0x86, 0x20, 0x00, 0x7C,
+    0xB8, 0x2D, 0x00, 0x7C, 0x86, 0x20, 0x00, 0x7C, 0x82, 0x20, 0x03, 0x45, 0x56, 0x45, 0x4E, 0x82,
+    0x20, 0x00, 0x7C, 0x82, 0x20, 0x02, 0x52, 0x45, 0x44, 0x83, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x04,
+    0x42, 0x4C, 0x41, 0x43, 0x4B, 0x82, 0x20, 0x00, 0x7C, 0x82, 0x20, 0x02, 0x4F, 0x44, 0x44, 0x83,
+    0x20, 0x00, 0x7C, 0x86, 0x20, 0xBA, 0x2D, 0xBB, 0x20, 0x8B, 0x2D, 0xB5, 0x20, 0x06, 0x7C, 0x42,
+    0x45, 0x54, 0x3A, 0x20, 0x24, 0x83, 0x20, 0x00, 0x7C, 0xB5, 0x20, 0x8B, 0x2D, 0x8A, 0x20, 0x0E,
+    0x42, 0x45, 0x54, 0x54, 0x49, 0x4E, 0x47, 0x20, 0x50, 0x41, 0x59, 0x4F, 0x55, 0x54, 0x53, 0x9A,
+    0x20, 0x04, 0x43, 0x48, 0x49, 0x50, 0x53, 0x85, 0x20, 0xAA, 0x2D, 0x81, 0x20, 0x92, 0x2D, 0x2C,
+    0x7C, 0x20, 0x53, 0x74, 0x72, 0x61, 0x69, 0x67, 0x68, 0x74, 0x3A, 0x20, 0x33, 0x35, 0x20, 0x74,
+    0x6F, 0x20, 0x31, 0x20, 0x7C, 0x20, 0x44, 0x6F, 0x75, 0x62, 0x6C, 0x65, 0x20, 0x53, 0x74, 0x72,
+    0x65, 0x65, 0x74, 0x3A, 0x20, 0x35, 0x20, 0x74, 0x6F, 0x20, 0x31, 0x20, 0x7C, 0x81, 0x20, 0x02,
+    0x7C, 0x24, 0x31, 0x80, 0x30, 0x00, 0x3A, 0x80, 0x20, 0x04, 0x7C, 0x24, 0x32, 0x35, 0x3A, 0x82,
+    0x20, 0x10, 0x7C, 0x7C, 0x20, 0x53, 0x70, 0x6C, 0x69, 0x74, 0x3A, 0x20, 0x31, 0x37, 0x20, 0x74,
+    0x6F, 0x20, 0x31, 0x81, 0x20, 0x0E, 0x7C, 0x20, 0x44, 0x6F, 0x7A, 0x65, 0x6E, 0x3A, 0x20, 0x32,
+    0x20, 0x74, 0x6F, 0x20, 0x31, 0x86, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x05, 0x7C, 0x24, 0x35, 0x30,
+    0x30, 0x3A, 0x81, 0x20, 0x04, 0x7C, 0x24, 0x31, 0x30, 0x3A, 0x82, 0x20, 0x11, 0x7C, 0x7C, 0x20,
+    0x53, 0x74, 0x72, 0x65, 0x65, 0x74, 0x3A, 0x20, 0x31, 0x31, 0x20, 0x74, 0x6F, 0x20, 0x31, 0x80,
+    0x20, 0x0F, 0x7C, 0x20, 0x43, 0x6F, 0x6C, 0x75, 0x6D, 0x6E, 0x3A, 0x20, 0x32, 0x20, 0x74, 0x6F,
+    0x20, 0x31, 0x85, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x05, 0x7C, 0x24, 0x31, 0x30, 0x30, 0x3A, 0x81,
+    0x20, 0x03, 0x7C, 0x24, 0x35, 0x3A, 0x83, 0x20, 0x11, 0x7C, 0x7C, 0x20, 0x42, 0x61, 0x73, 0x6B,
+    0x65, 0x74, 0x3A, 0x20, 0x31, 0x31, 0x20, 0x74, 0x6F, 0x20, 0x31, 0x80, 0x20, 0x12, 0x7C, 0x20,
+    0x52, 0x65, 0x64, 0x2F, 0x42, 0x6C, 0x61, 0x63, 0x6B, 0x3A, 0x20, 0x31, 0x20, 0x74, 0x6F, 0x20,
+    0x31, 0x82, 0x20, 0x00, 0x7C, 0x81, 0x20, 0x04, 0x7C, 0x24, 0x35, 0x30, 0x3A, 0x82, 0x20, 0x03,
+    0x7C, 0x24, 0x31, 0x3A, 0x83, 0x20, 0x10, 0x7C, 0x7C, 0x20, 0x43, 0x6F, 0x72, 0x6E, 0x65, 0x72,
+    0x3A, 0x20, 0x38, 0x20, 0x74, 0x6F, 0x20, 0x31, 0x81, 0x20, 0x11, 0x7C, 0x20, 0x4F, 0x64, 0x64,
+    0x2F, 0x45, 0x76, 0x65, 0x6E, 0x3A, 0x20, 0x31, 0x20, 0x74, 0x6F, 0x20, 0x31, 0x83, 0x20, 0x00,
+    0x7C, 0x81, 0x20, 0x92, 0x2D, 0x25, 0x7C, 0x20, 0x54, 0x6F, 0x70, 0x20, 0x4C, 0x69, 0x6E, 0x65,
+    0x3A, 0x20, 0x35, 0x20, 0x74, 0x6F, 0x20, 0x31, 0x20, 0x20, 0x7C, 0x20, 0x4C, 0x6F, 0x77, 0x2F,
+    0x48, 0x69, 0x67, 0x68, 0x3A, 0x20, 0x31, 0x20, 0x74, 0x6F, 0x20, 0x31, 0x83, 0x20, 0x00, 0x7C,
+    0x81, 0x20, 0x0A, 0x7C, 0x42, 0x41, 0x4C, 0x41, 0x4E, 0x43, 0x45, 0x3A, 0x20, 0x24, 0x86, 0x20,
+    0x00, 0x7C, 0xAA, 0x2D, 0x81, 0x20, 0xD8, 0x2D, 0xC3, 0x20, 0xC3, 0x2D, 0x9C, 0x00, 0x85, 0x30,
+    0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00,
+    0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0x92, 0x00, 0xBB, 0x10, 0xFD, 0x00,
+    0x82, 0x04, 0x82, 0x00, 0x80, 0x01, 0xB6, 0x00, 0x81, 0x05, 0x83, 0x00, 0x80, 0x07, 0xB6, 0x00,
+    0x81, 0x03, 0x83, 0x00, 0x01, 0x02, 0x02, 0xB7, 0x00, 0x80, 0x06, 0xFF, 0x00, 0xFF, 0x00, 0xFF,
+    0x00, 0xAC, 0x00
+};
+
+#endif
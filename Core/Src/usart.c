@@ -1,92 +1,80 @@
 #include "usart.h"
+#include "payouts.h"
+#include "screen.h"
+#include "format.h"
+#include <stdbool.h>
+#include <string.h>
 
 #define USART_PORT GPIOA //USART port
 #define USART_AF 7 //USART alternating function
 #define SYSTEM_CLK_FREQ 80000000 //80MHz MCU clock
 #define BAUD_RATE 115200 //baud rate
+#define BITS_PER_BYTE 10 //start, 8 data and stop bits
 #define NVIC_MASK 0x1F //mask bottom 5 bits
-#define WHEEL_OUTLINE 4 //number of lines in wheel outline
-#define TABLE_OUTLINE 16 //number of lines in table outline
-#define BOTTOM_OUTLINE 10 //number of lines in bottom container outline
+#define TX_RING_MASK (USART_TX_RING_SIZE - 1) //ring index from a free running count
+#define DMA_USART2_TX 2 //DMA1 channel 7 request for USART2_TX
+#define PAINT_BACKLOG 128 //most bytes queued ahead of a row of the start screen painting
+
+//screen rows and columns, 1 based
+#define WHEEL_ROW 6 //pockets in the wheel window
+#define WHEEL_STEP 5 //columns from one wheel window cell to the next
+#define BET_ROW 24
+#define BET_COL 64
+#define BET_WIDTH 6
+#define BALANCE_ROW 33
+#define BALANCE_COL 61
+#define BALANCE_WIDTH 8
+#define CHIP_COUNT_WIDTH 3
+#define REPORT_NAME_WIDTH 12 //transmit report column of game states
+#define REPORT_WIDTH 7 //transmit report columns of numbers, the name and 8 of them fit SCREEN_COLS
 
 //escape codes
 #define ESC "\x1B"
 #define HIDE_CURSOR "[?25l"
-#define UNDERLINE "[4m"
-#define BOLD "[1m"
 #define CLEAR_SCREEN "[2J"
+#define SAVE_CURSOR "7"
+#define RESTORE_CURSOR "8"
+#define ALTERNATE_SCREEN "[?1049h" //switch to a blank screen, the game screen is kept
+#define GAME_SCREEN "[?1049l" //switch back to the game screen and its cursor
+#define ERASE_LINE_END "[K"
 
-#define RIGHT_1 "[1C"
-#define RIGHT_2 "[2C"
-#define RIGHT_3 "[3C"
-#define RIGHT_5 "[5C"
-#define RIGHT_6 "[6C"
-#define RIGHT_14 "[14C"
-#define RIGHT_31 "[31C"
-#define RIGHT_50 "[50C"
-#define RIGHT_60 "[60C"
-#define RIGHT_63 "[63C"
-
-#define LEFT_6 "[6D"
-#define LEFT_8 "[8D"
-
-#define DOWN_1 "[1B"
-#define DOWN_2 "[2B"
-#define DOWN_5 "[5B"
-#define DOWN_12 "[12B"
-#define DOWN_23 "[23B"
-#define DOWN_32 "[32B"
-
-#define UP_9 "[9A"
-
-#define YELLOW "[33m"
-#define PURPLE "[35m"
-#define BLACK "[30m"
-#define ORANGE "[38:5:202m"
-#define GREEN "[32m"
-#define BLUE "[34m"
-#define RED "[31m"
-#define CYAN "[96m"
-
-const char *wheel_outline[] = { //outline for wheel
-    "####",
-    "	     -------------------|----|-------------------",
-    "	         |    |    |    |    |    |    |    |    ",
-    "	     -------------------|----|-------------------\n\n"
-};
+//first wheel window label
+#if WHEEL_ZEROS == 3
+#define WHEEL_COL 14 //labels start a column early to fit "000"
+#define WHEEL_LABEL_WIDTH 3
+#else
+#define WHEEL_COL 15
+#define WHEEL_LABEL_WIDTH 2
+#endif
 
-const char *table_outline[] = { //outline for table
-    "   -------------------------------------------------------------",
-    "   |            1 - 18           |           19 - 36           |",
-    "---|-----------------------------|-----------------------------|------",
-    "|  |    |    |    |    |    |    |    |    |    |    |    |    | 3rd |",
-    "|  |----|----|----|----|----|----|----|----|----|----|----|----|-----|",
-    "|--|    |    |    |    |    |    |    |    |    |    |    |    | 2nd |",
-    "|  |----|----|----|----|----|----|----|----|----|----|----|----|-----|",
-    "|  |    |    |    |    |    |    |    |    |    |    |    |    | 1st |",
-    "---|-------------------|-------------------|-------------------|------",
-    "   |       1 - 12      |      13 - 24      |      25 - 36      |",
-    "   |-----------------------------------------------------------|",
-    "   |     EVEN     |     RED      |    BLACK     |     ODD      |",
-    "   -------------------------------------------------------------",
-	"                                                        --------------",
-	"                                                        |BET: $      |",
-	"                                                        --------------"
-};
+//screen color of each spot color, indexed by SpotColor
+static const uint8_t spot_color_attrs[] = {COLOR_GREEN, COLOR_RED, COLOR_BLACK};
 
-const char *bottom_container_outline[] = { //outline for bottom container
-    "---------------------------------------------    ---------------------",
-    "| Straight: 35 to 1 | Double Street: 5 to 1 |    |     :   |   :     |",
-    "| Split: 17 to 1    | Dozen: 2 to 1         |    |    :    |   :     |",
-    "| Street: 11 to 1   | Column: 2 to 1        |    |    :    |  :      |",
-    "| Basket: 11 to 1   | Red/Black: 1 to 1     |    |   :     |$1:      |",
-    "| Corner: 8 to 1    | Odd/Even: 1 to 1      |    ---------------------",
-    "| Top Line: 6 to 1  | Low/High: 1 to 1      |    |BALANCE: $         |",
-    "---------------------------------------------    ---------------------",
-    "----------------------------------------------------------------------\n",
-    "----------------------------------------------------------------------"
+//screen cell of each chip count, in Chips order
+static const TableCell chip_count_cells[POSSIBLE_CHIPS] = {
+    {28, 57}, {29, 56}, {30, 56}, {31, 55}, {28, 65}, {29, 65}, {30, 64}, {31, 64}
 };
 
+static Screen screen; //what the terminal shows, every draw below goes to it and is flushed
+static bool painting = false; //rows of the start screen are still going out one at a time
+
+//bytes waiting for the transmit DMA, written by any context and drained by DMA1 channel 7
+//the counts run free, the ring holds tx_head - tx_tail bytes from index tx_tail & TX_RING_MASK
+static char tx_ring[USART_TX_RING_SIZE];
+static volatile uint32_t tx_head = 0; //bytes queued
+static volatile uint32_t tx_tail = 0; //bytes the DMA has finished with
+static volatile uint32_t tx_dma_start = 0; //tx_tail when the transfer in flight started
+static volatile uint16_t tx_dma_length = 0; //bytes of the transfer in flight, 0 when idle
+static UsartTxStats tx_stats = {0};
+static uint32_t tx_region_bytes[USART_TX_STATES][NUM_REGIONS] = {0}; //bytes written per game state and region
+static volatile uint8_t tx_state = 0; //game state the writes count against
+static volatile UsartRegion tx_region = REGION_PROMPT; //region the writes count against
+static volatile bool tx_counting = true; //writes count against the state and region, not while the report is up
+static uint32_t tx_input_mark = 0; //prompt bytes of the state when the line being typed began
+
+//transmit report column headings, indexed by UsartRegion
+static const char *region_names[NUM_REGIONS] = {"start", "wheel", "table", "chips", "bal", "bet", "prompt"};
+
 //configure USART registers and pins
 void USART_init(void) {
 	//enable GPIOA clock
@@ -115,262 +103,426 @@ void USART_init(void) {
 	//enable receiver and receiver interrupts
 	USART2->CR1 |= (USART_CR1_TE | USART_CR1_RE | USART_CR1_RXNEIE);
 	NVIC->ISER[1] |= (1 << (USART2_IRQn & NVIC_MASK));
+	//transmit through DMA1 channel 7, memory to TDR a byte at a time
+	RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+	DMA1_CSELR->CSELR &= ~DMA_CSELR_C7S;
+	DMA1_CSELR->CSELR |= (DMA_USART2_TX << DMA_CSELR_C7S_Pos);
+	DMA1_Channel7->CCR &= ~(DMA_CCR_EN | DMA_CCR_CIRC | DMA_CCR_PINC | DMA_CCR_PSIZE | DMA_CCR_MSIZE);
+	DMA1_Channel7->CCR |= (DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE);
+	DMA1_Channel7->CPAR = (uintptr_t)&USART2->TDR;
+	NVIC->ISER[0] |= (1 << (DMA1_Channel7_IRQn & NVIC_MASK));
+	USART2->CR3 |= USART_CR3_DMAT;
 	//enable USART
 	USART2->CR1 |= USART_CR1_UE;
 }
 
+//start a transfer of the queued bytes up to the end of the ring if the DMA is idle,
+//called with interrupts disabled
+static void USART_tx_start(void) {
+	uint32_t queued = tx_head - tx_tail;
+	if (tx_dma_length != 0 || queued == 0) {
+		return;
+	}
+	uint32_t start = tx_tail & TX_RING_MASK;
+	uint32_t length = (queued < USART_TX_RING_SIZE - start) ? queued : USART_TX_RING_SIZE - start;
+	tx_dma_start = tx_tail;
+	tx_dma_length = (uint16_t)length;
+	DMA1->IFCR = DMA_IFCR_CGIF7;
+	DMA1_Channel7->CMAR = (uintptr_t)&tx_ring[start];
+	DMA1_Channel7->CNDTR = length;
+	DMA1_Channel7->CCR |= DMA_CCR_EN;
+	tx_stats.transfers++;
+}
+
+//release the bytes the DMA has sent and start the next transfer, from the interrupt or from
+//a writer waiting for room (which may itself be an interrupt the DMA one cannot preempt)
+static void USART_tx_service(void) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	uint32_t flags = DMA1->ISR;
+	if (flags & (DMA_ISR_TCIF7 | DMA_ISR_TEIF7)) {
+		//whole transfer done, or abandoned after a bus error
+		DMA1->IFCR = DMA_IFCR_CGIF7;
+		DMA1_Channel7->CCR &= ~DMA_CCR_EN;
+		tx_tail = tx_dma_start + tx_dma_length;
+		tx_stats.errors += (flags & DMA_ISR_TEIF7) ? tx_dma_length : 0;
+		tx_dma_length = 0;
+		USART_tx_start();
+	} else if (flags & DMA_ISR_HTIF7) {
+		//first half sent, hand it back to the writers early
+		DMA1->IFCR = DMA_IFCR_CHTIF7;
+		tx_tail = tx_dma_start + (tx_dma_length / 2);
+	}
+	__set_PRIMASK(primask);
+}
+
+//ISR for DMA1 channel 7, USART2 transmit half and complete transfers
+void DMA1_Channel7_IRQHandler(void) {
+	USART_tx_service();
+}
+
+//queue bytes for transmission and return, the DMA sends them in the background
+//a full ring makes the writer wait for room rather than lose bytes, which would leave the
+//terminal inside half an escape code, so size the ring above the largest burst
+void USART_write(const char* data, uint32_t length) {
+	bool waited = false;
+	while (length > 0) {
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		uint32_t room = USART_TX_RING_SIZE - (tx_head - tx_tail);
+		uint32_t count = (length < room) ? length : room;
+		uint32_t start = tx_head & TX_RING_MASK;
+		uint32_t first = (count < USART_TX_RING_SIZE - start) ? count : USART_TX_RING_SIZE - start;
+		memcpy(&tx_ring[start], data, first);
+		memcpy(tx_ring, data + first, count - first);
+		tx_head += count;
+		tx_stats.queued += count;
+		tx_region_bytes[tx_state][tx_region] += tx_counting ? count : 0;
+		tx_stats.peak = (tx_head - tx_tail > tx_stats.peak) ? tx_head - tx_tail : tx_stats.peak;
+		USART_tx_start();
+		__set_PRIMASK(primask);
+		data += count;
+		length -= count;
+		if (length > 0) {
+			tx_stats.full_waits += waited ? 0 : 1;
+			waited = true;
+			USART_tx_service();
+		}
+	}
+}
+
+//wait until every queued byte has been handed to the USART
+//and, while the start screen is painting, until all of it has been
+void USART_tx_flush(void) {
+	while (painting || tx_head != tx_tail) {
+		USART_paint_screen();
+		USART_tx_service();
+	}
+}
+
+//copy of the transmit counters
+UsartTxStats USART_tx_stats(void) {
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	UsartTxStats stats = tx_stats;
+	stats.sent = tx_tail;
+	__set_PRIMASK(primask);
+	return stats;
+}
+
+//count the writes that follow against a region, returns the region they counted against before
+//so a drawing, or an interrupt printing in the middle of one, can put it back
+UsartRegion USART_tx_region(UsartRegion region) {
+	UsartRegion previous = tx_region;
+	tx_region = region;
+	return previous;
+}
+
+//count the writes that follow against a game state
+void USART_tx_state(uint8_t state) {
+	tx_state = (state < USART_TX_STATES) ? state : USART_TX_STATES - 1;
+}
+
+//note where the echo of a typed line begins, so the report command can take its own echo back
+void USART_tx_input_start(void) {
+	tx_input_mark = tx_region_bytes[tx_state][REGION_PROMPT];
+}
+
+//bytes written in a game state to a region since power up
+uint32_t USART_tx_region_bytes(uint8_t state, UsartRegion region) {
+	return tx_region_bytes[state][region];
+}
+
 //transmit character
 void USART_print_char(char input) {
-	//wait until TXE is set
-	while (!(USART2->ISR & USART_ISR_TXE));
-	//transmit character
-	USART2->TDR = input;
+	USART_write(&input, 1);
 }
 
 //transmit a string of characters
-void USART_print_string(char* input) {
-	//continue to transmit characters until reaching end of string
-    while (*input != '\0') {
-    	USART_print_char(*input);
-        input++;
-    }
+void USART_print_string(const char* input) {
+	USART_write(input, strlen(input));
+}
+
+//transmit a number in decimal
+void USART_print_number(uint32_t value) {
+	char text[FORMAT_SIZE];
+	USART_write(text, format_number(text, value));
+}
+
+//transmit an amount of dollars, "$" and the number
+void USART_print_currency(uint32_t value) {
+	char text[FORMAT_SIZE];
+	USART_write(text, format_currency(text, value));
 }
 
 //print ESC character, then print desired ESC code
-void USART_ESC_Code(char* code) {
+void USART_ESC_Code(const char* code) {
 	USART_print_string(ESC);
 	USART_print_string(code);
 }
 
-//reset terminal screen
+//reset terminal screen, the shadow screen starts over blank with it
 void USART_reset_screen(void) {
+	UsartRegion region = USART_tx_region(REGION_START);
 	USART_ESC_Code(CLEAR_SCREEN);
 	USART_ESC_Code(TOP_LEFT);
 	USART_ESC_Code(RESET_ATTRIBUTES);
 	USART_ESC_Code(HIDE_CURSOR);
+	USART_tx_region(region);
+	screen_init(&screen);
 }
 
-//print line (of table/wheel outline)
-void USART_print_line(char* line) {
-	USART_print_string(line);
-	USART_ESC_Code(DOWN_1);
-	USART_ESC_Code(FULLY_LEFT);
+//send one more row of the start screen while the transmit ring is nearly empty, so painting
+//never holds up the prompt or the echo of typing by more than PAINT_BACKLOG bytes. each row goes
+//out whole with interrupts off between a cursor save and restore, so the prompt cursor and the
+//echo stay where they were. called from the main loop until painting ends, it releases what
+//the DMA has sent itself so painting goes on before interrupts are enabled too
+void USART_paint_screen(void) {
+	while (painting) {
+		USART_tx_service();
+		uint8_t row = screen_dirty_row(&screen);
+		if (row == 0) {
+			painting = false;
+			break;
+		}
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		uint32_t queued = tx_head - tx_tail;
+		bool room = queued <= PAINT_BACKLOG && USART_TX_RING_SIZE - queued >= SCREEN_ROW_BYTES + 4;
+		if (room) {
+			UsartRegion region = USART_tx_region(REGION_START);
+			USART_ESC_Code(SAVE_CURSOR);
+			screen_flush_row(&screen, row, USART_write);
+			USART_ESC_Code(RESTORE_CURSOR);
+			USART_tx_region(region);
+		}
+		__set_PRIMASK(primask);
+		if (!room) {
+			break;
+		}
+	}
 }
 
-//print inputted section line by line
-void USART_print_section(const char **lines, uint8_t count) {
-    for (uint8_t i = 0; i < count; i++) {
-        USART_print_line(lines[i]);
-    }
+//send what changed on the screen since the last flush, or as much as painting allows while the
+//start screen is still going out
+void USART_flush_screen(void) {
+	if (painting) {
+		USART_paint_screen();
+	} else {
+		screen_flush(&screen, USART_write);
+	}
 }
 
-//print start screen
+//print start screen, the outlines come packed from flash into the shadow screen and are painted
+//a row at a time behind whatever the game prints meanwhile
 void USART_start_screen(void) {
 	//reset screen
 	USART_reset_screen();
-    //print title
-    USART_ESC_Code(RIGHT_31);
-    USART_ESC_Code(BOLD);
-    USART_ESC_Code(UNDERLINE);
-    USART_print_string("ROULETTE\n\n\n");
-    USART_ESC_Code(RESET_ATTRIBUTES);
-    USART_ESC_Code(LEFT_6);
-    //print wheel outline
-    USART_print_section(wheel_outline, WHEEL_OUTLINE);
-    //print table outline
-    USART_print_section(table_outline, TABLE_OUTLINE);
-    //print bottom container outline
-    USART_ESC_Code(BOLD);
-    USART_print_string("             BETTING PAYOUTS                             CHIPS\n");
-    USART_ESC_Code(FULLY_LEFT);
-    USART_ESC_Code(RESET_ATTRIBUTES);
-    USART_print_section(bottom_container_outline, BOTTOM_OUTLINE);
-	//print colored chip values
-	USART_ESC_Code(UP_9);
-	USART_ESC_Code(FULLY_LEFT);
-	USART_ESC_Code(RIGHT_50);
-	USART_ESC_Code(YELLOW);
-	USART_print_string("$1000");
-	USART_ESC_Code(GREEN);
-	USART_ESC_Code(RIGHT_5);
-	USART_print_string("$25\n");
-
-	USART_ESC_Code(FULLY_LEFT);
-	USART_ESC_Code(RIGHT_50);
-	USART_ESC_Code(PURPLE);
-	USART_print_string("$500");
-	USART_ESC_Code(BLUE);
-	USART_ESC_Code(RIGHT_6);
-	USART_print_string("$10\n");
-
-	USART_ESC_Code(FULLY_LEFT);
-	USART_ESC_Code(RIGHT_50);
-	USART_ESC_Code(BLACK);
-	USART_print_string("$100");
-	USART_ESC_Code(RED);
-	USART_ESC_Code(RIGHT_6);
-	USART_print_string("$5\n");
-
-	USART_ESC_Code(FULLY_LEFT);
-	USART_ESC_Code(RIGHT_50);
-	USART_ESC_Code(ORANGE);
-	USART_print_string("$50");
-	USART_ESC_Code(RESET_ATTRIBUTES);
+	screen_load(&screen, start_screen_packed);
+	painting = true;
+	USART_paint_screen();
 }
 
-//print given table spots in correct locations with appropriate colors
-void USART_print_table(Spot *table_arr) {
-	USART_ESC_Code(TOP_LEFT);
-	USART_ESC_Code(DOWN_12);
-	USART_ESC_Code(RIGHT_1);
-	USART_ESC_Code(BOLD);
-    //print "00"
-    if (strcmp(table_arr[0].color, "cyan") == 0) {
-        USART_ESC_Code(CYAN);
-    } else {
-        USART_ESC_Code(GREEN);
-    }
-	USART_print_string(table_arr[0].number);
-	USART_ESC_Code(RIGHT_2);
-    //print columns
-    for (uint8_t i = 2; i <= ARR_SIZE - 1; i++) {
-    	//choose color
-        if (strcmp(table_arr[i].color, "red") == 0) {
-            USART_ESC_Code(RED);
-        } else if (strcmp(table_arr[i].color, "black") == 0) {
-        	USART_ESC_Code(BLACK);
-        } else if (strcmp(table_arr[i].color, "cyan") == 0) {
-            USART_ESC_Code(CYAN);
-        }
-        USART_print_string(table_arr[i].number);
-    	USART_ESC_Code(RIGHT_3);
-    	//adjust at end of row
-    	if (i == 13 || i == 25) {
-    		USART_ESC_Code(FULLY_LEFT);
-    		USART_ESC_Code(DOWN_2);
-    		USART_ESC_Code(RIGHT_5);
-    	}
-    }
-	USART_ESC_Code(FULLY_LEFT);
-	USART_ESC_Code(RIGHT_1);
-	//print "0"
-    if (strcmp(table_arr[1].color, "cyan") == 0) {
-        USART_ESC_Code(CYAN);
-    } else {
-        USART_ESC_Code(GREEN);
-    }
-	USART_print_string(table_arr[1].number);
-	USART_ESC_Code(RESET_ATTRIBUTES);
+//screen attributes of a spot in its own color, or cyan if highlighted
+static uint8_t USART_spot_attr(Spot spot, PocketMask highlighted) {
+    uint8_t color = (highlighted & POCKET_BIT(spot)) ? COLOR_CYAN : spot_color_attrs[spot_colors[spot]];
+    return ATTR_BOLD | color;
 }
 
-//print wheel in wheel outline
+//move the cursor to a screen position, 1 based
+void USART_move_cursor(uint8_t row, uint8_t col) {
+	char code[10]; //"[", two numbers of up to 3 digits, ";", "H" and the terminator
+	uint8_t length = 0;
+	code[length++] = '[';
+	length += format_number(&code[length], row);
+	code[length++] = ';';
+	length += format_number(&code[length], col);
+	code[length++] = 'H';
+	code[length] = '\0';
+	USART_ESC_Code(code);
+}
+
+//print table spots in their generated cells with appropriate colors, highlighting the given pockets
+//only the spots whose highlight changed go out
+void USART_print_table(PocketMask highlighted) {
+	UsartRegion region = USART_tx_region(REGION_TABLE);
+	for (uint8_t i = 0; i < ARR_SIZE; i++) {
+		Spot spot = base_table_arr[i];
+		const TableCell *cell = &table_cells[spot];
+		screen_put(&screen, cell->row, cell->col, spot_labels[spot], USART_spot_attr(spot, highlighted));
+	}
+	USART_flush_screen();
+	USART_tx_region(region);
+}
+
+//print wheel in wheel outline, each pocket right aligned in its cell so a wide label moving
+//along leaves nothing behind
 Spot USART_print_wheel(const Spot *wheel_arr, uint32_t index) {
 	//number of spots to display in the row
     const uint8_t display_count = 9;
     const uint8_t half_window = display_count / 2;
     //calculate the starting index for the circular array
     uint8_t start_index = (index - half_window + ARR_SIZE) % ARR_SIZE;
-    //navigate to outline
-    USART_ESC_Code(TOP_LEFT);
-    USART_ESC_Code(DOWN_5);
-    USART_ESC_Code(RIGHT_14);
-    USART_ESC_Code(BOLD);
+    UsartRegion region = USART_tx_region(REGION_WHEEL);
     //variable to hold middle "winning" spot
     Spot winning_spot = wheel_arr[(start_index + half_window) % ARR_SIZE];
-    //print the 9 spots
+    //draw the 9 spots
     for (uint8_t i = 0; i < display_count; i++) {
         //compute the current index in the circular array
-    	uint8_t current_index = (start_index + i) % ARR_SIZE;
-        //set color for the spot
-        if (strcmp(wheel_arr[current_index].color, "red") == 0) {
-        	USART_ESC_Code(RED);
-        } else if (strcmp(wheel_arr[current_index].color, "black") == 0) {
-        	USART_ESC_Code(BLACK);
-        } else if (strcmp(wheel_arr[current_index].color, "green") == 0) {
-        	USART_ESC_Code(GREEN);
-        }
-        //print the number
-        USART_print_string(wheel_arr[current_index].number);
-        USART_ESC_Code(RIGHT_3);
+    	Spot spot = wheel_arr[(start_index + i) % ARR_SIZE];
+    	uint8_t col = WHEEL_COL + (i * WHEEL_STEP);
+    	uint8_t pad = WHEEL_LABEL_WIDTH - strlen(spot_labels[spot]);
+    	screen_fill(&screen, WHEEL_ROW, col, pad, ' ', 0);
+    	screen_put(&screen, WHEEL_ROW, col + pad, spot_labels[spot], USART_spot_attr(spot, 0));
     }
+    USART_flush_screen();
+    USART_tx_region(region);
     return winning_spot; //return winning spot
 }
 
+//draw a number left aligned in a field, spaces clear the rest of it
+static void USART_draw_number(uint8_t row, uint8_t col, uint8_t width, uint32_t value) {
+    char field[FORMAT_SIZE]; //wider than any field
+    format_field(field, value, width, ALIGN_LEFT);
+    screen_put(&screen, row, col, field, 0);
+}
+
 //print inputted balance
 void USART_print_balance(uint32_t balance) {
-    char balance_str[12]; //character buffer
-    //navigate to balance position
-    USART_ESC_Code(TOP_LEFT);
-    USART_ESC_Code(RESET_ATTRIBUTES);
-    USART_ESC_Code(DOWN_32);
-    USART_ESC_Code(RIGHT_60);
-    //clear spots by overwriting with spaces
-    for (uint8_t i = 0; i < 8; i++) {
-        USART_print_char(' ');
-    }
-    //move cursor back to the start of the cleared area
-    USART_ESC_Code(LEFT_8);
-    //convert balance to string and print
-    snprintf(balance_str, sizeof(balance_str), "%lu", balance);
-    USART_print_string(balance_str);
+    UsartRegion region = USART_tx_region(REGION_BALANCE);
+    USART_draw_number(BALANCE_ROW, BALANCE_COL, BALANCE_WIDTH, balance);
+    USART_flush_screen();
+    USART_tx_region(region);
 }
 
 //print inputted bet
 void USART_print_bet(uint32_t bet) {
-    char bet_str[12]; //character buffer
-    //naviagte to bet position
-    USART_ESC_Code(TOP_LEFT);
-    USART_ESC_Code(RESET_ATTRIBUTES);
-    USART_ESC_Code(DOWN_23);
-    USART_ESC_Code(RIGHT_63);
-    //clear spots by overwriting with spaces
-    for (uint8_t i = 0; i < 6; i++) {
-        USART_print_char(' ');
-    }
-    //move cursor back to the start of the cleared area
-    USART_ESC_Code(LEFT_6);
-    //convert bet to string and print
-    snprintf(bet_str, sizeof(bet_str), "%lu", bet);
-    USART_print_string(bet_str);
+    UsartRegion region = USART_tx_region(REGION_BET);
+    USART_draw_number(BET_ROW, BET_COL, BET_WIDTH, bet);
+    USART_flush_screen();
+    USART_tx_region(region);
 }
 
-//print inputted chips
+//print inputted chips, bet and balance, each flushed on its own so its bytes count against its
+//region
 void USART_print_chips(Chips *chips, uint32_t bet) {
-    char chip_count_str[4]; //buffer to store chip counts
-    USART_ESC_Code(RESET_ATTRIBUTES);
-    //clear the area and print chip values
-    void USART_clear_and_print(uint8_t down, uint8_t right, uint32_t value) {
-        //navigate to position
-        USART_ESC_Code(TOP_LEFT);
-        for (uint8_t i = 0; i < down; i++) {
-            USART_ESC_Code(DOWN_1);
-        }
-        for (uint8_t i = 0; i < right; i++) {
-            USART_ESC_Code(RIGHT_1);
-        }
-        //clear area (overwrite with spaces)
-        for (uint8_t i = 0; i < 3; i++) {
-            USART_print_char(' ');
-        }
-        //move back to the start of the cleared area
-        for (uint8_t i = 0; i < 3; i++) {
-            USART_ESC_Code(LEFT_1);
-        }
-        //print the value
-        snprintf(chip_count_str, sizeof(chip_count_str), "%lu", value);
-        USART_print_string(chip_count_str);
+    UsartRegion region = USART_tx_region(REGION_CHIPS);
+    const uint32_t counts[POSSIBLE_CHIPS] = {
+        chips->yellow, chips->purple, chips->black, chips->orange,
+        chips->green, chips->blue, chips->red, chips->white
+    };
+    //draw chips in corresponding spots
+    for (uint8_t i = 0; i < POSSIBLE_CHIPS; i++) {
+        USART_draw_number(chip_count_cells[i].row, chip_count_cells[i].col, CHIP_COUNT_WIDTH, counts[i]);
     }
-    //print chips in corresponding spots
-    USART_clear_and_print(27, 56, chips->yellow); //$1000 chips
-    USART_clear_and_print(28, 55, chips->purple); //$500 chips
-    USART_clear_and_print(29, 55, chips->black); //$100 chips
-    USART_clear_and_print(30, 54, chips->orange); //$50 chips
-    USART_clear_and_print(27, 64, chips->green); //$25 chips
-    USART_clear_and_print(28, 64, chips->blue); //$10 chips
-    USART_clear_and_print(29, 63, chips->red); //$5 chips
-    USART_clear_and_print(30, 63, chips->white); //$1 chips
+    USART_flush_screen();
     //update total balance and bet
-    uint32_t total_balance = calculate_total_balance(*chips);
     USART_print_bet(bet);
-    USART_print_balance(total_balance);
+    USART_print_balance(calculate_total_balance(*chips));
+    USART_tx_region(region);
+}
+
+//print text padded with spaces to a transmit report column
+static void USART_print_padded(const char *text, uint8_t width, FormatAlign align) {
+    uint8_t length = strlen(text);
+    for (uint8_t i = length; i < width && align == ALIGN_RIGHT; i++) {
+        USART_print_char(' ');
+    }
+    USART_print_string(text);
+    for (uint8_t i = length; i < width && align == ALIGN_LEFT; i++) {
+        USART_print_char(' ');
+    }
+}
+
+//print a number right aligned in a transmit report column, one too wide for it in thousands (K)
+//or millions (M) rounded down rather than cut to its leading digits
+static void USART_print_column(uint32_t value) {
+    static const char units[] = " KM"; //a uint32_t is under 5000M
+    char text[FORMAT_SIZE];
+    uint8_t unit = 0;
+    uint8_t length = format_number(text, value);
+    while (length + (unit != 0) > REPORT_WIDTH) {
+        value /= 1000;
+        unit++;
+        length = format_number(text, value);
+    }
+    if (unit != 0) {
+        text[length++] = units[unit];
+        text[length] = '\0';
+    }
+    USART_print_padded(text, REPORT_WIDTH, ALIGN_RIGHT);
+}
+
+//show the transmit counters on the terminal's alternate screen, leaving the game screen as it
+//is underneath: bytes per game state (named by state_names) and region, their totals and the
+//time the totals took on the wire, then the timer interrupt's cycles and the wheel frames of the
+//latest spin from spin_stats. neither the report nor the echo of the command typed to open it
+//count against the game, counting stops until USART_close_tx_report() goes back
+void USART_open_tx_report(const char **state_names, const UsartSpinStats *spin_stats) {
+    uint32_t counts[USART_TX_STATES][NUM_REGIONS];
+    uint32_t totals[NUM_REGIONS + 1] = {0};
+    tx_region_bytes[tx_state][REGION_PROMPT] = tx_input_mark;
+    tx_counting = false;
+    memcpy(counts, tx_region_bytes, sizeof(counts));
+    USART_ESC_Code(ALTERNATE_SCREEN);
+    USART_ESC_Code(CLEAR_SCREEN);
+    USART_ESC_Code(TOP_LEFT);
+    USART_print_string("Bytes sent by game state and screen region since power up\r\n\r\n");
+    USART_print_padded("state", REPORT_NAME_WIDTH, ALIGN_LEFT);
+    for (uint8_t r = 0; r < NUM_REGIONS; r++) {
+        USART_print_padded(region_names[r], REPORT_WIDTH, ALIGN_RIGHT);
+    }
+    USART_print_padded("total", REPORT_WIDTH, ALIGN_RIGHT);
+    for (uint8_t state = 0; state < USART_TX_STATES; state++) {
+        uint32_t total = 0;
+        USART_print_string("\r\n");
+        USART_print_padded(state_names[state], REPORT_NAME_WIDTH, ALIGN_LEFT);
+        for (uint8_t r = 0; r < NUM_REGIONS; r++) {
+            uint32_t bytes = counts[state][r];
+            USART_print_column(bytes);
+            total += bytes;
+            totals[r] += bytes;
+        }
+        USART_print_column(total);
+        totals[NUM_REGIONS] += total;
+    }
+    USART_print_string("\r\n");
+    USART_print_padded("total", REPORT_NAME_WIDTH, ALIGN_LEFT);
+    for (uint8_t r = 0; r <= NUM_REGIONS; r++) {
+        USART_print_column(totals[r]);
+    }
+    USART_print_string("\r\n");
+    USART_print_padded("ms on wire", REPORT_NAME_WIDTH, ALIGN_LEFT);
+    for (uint8_t r = 0; r <= NUM_REGIONS; r++) {
+        USART_print_column((uint32_t)(((uint64_t)totals[r] * BITS_PER_BYTE * 1000) / BAUD_RATE));
+    }
+    USART_print_string("\r\n\r\nSpin timer cycles: last ");
+    USART_print_number(spin_stats->timer.last);
+    USART_print_string(", worst ");
+    USART_print_number(spin_stats->timer.worst);
+    USART_print_string(", mean ");
+    USART_print_number(spin_stats->timer.count ? (uint32_t)(spin_stats->timer.cycles / spin_stats->timer.count) : 0);
+    USART_print_string("\r\nLast spin wheel frames: ");
+    USART_print_number(spin_stats->posted);
+    USART_print_string(" posted, ");
+    USART_print_number(spin_stats->drawn);
+    USART_print_string(" drawn, ");
+    USART_print_number(spin_stats->dropped);
+    USART_print_string(" over budget");
+    USART_print_string("\r\n\r\nPress Enter to return to the game.");
+}
+
+//back to the game screen from the transmit report, rubbing out the echo of the command typed
+//on the prompt line
+void USART_close_tx_report(void) {
+    char code[FORMAT_SIZE + 2]; //"[", the count, "D" and the terminator
+    uint8_t length = 0;
+    code[length++] = '[';
+    length += format_number(&code[length], strlen(TX_REPORT_COMMAND));
+    code[length++] = 'D';
+    code[length] = '\0';
+    USART_ESC_Code(GAME_SCREEN);
+    USART_ESC_Code(code);
+    USART_ESC_Code(ERASE_LINE_END);
+    tx_counting = true;
 }
@@ -2,7 +2,6 @@
 #define SRC_USART_H_
 #include "spots.h"
 #include "misc.h"
-#include <stdio.h>
 
 #define DOWN_35 "[35B"
 #define LEFT_1 "[1D"
@@ -11,14 +10,63 @@
 #define CLEAR_LINE "[2K"
 #define FULLY_LEFT "[1G"
 #define RESET_ATTRIBUTES "[0m"
+#define USART_TX_RING_SIZE 2048 //bytes queued for the transmit DMA, power of 2
+#define USART_TX_STATES 8 //game states the transmit counters keep apart, as many as GameState in main.c
+#define TX_REPORT_COMMAND "tx stats" //typed at any prompt to see the transmit counters
+
+//parts of the terminal the transmit counters keep apart, every byte counts against the region
+//being drawn when it is written
+typedef enum {
+    REGION_START, //clearing and painting the start screen
+    REGION_WHEEL,
+    REGION_TABLE,
+    REGION_CHIPS, //chip counts
+    REGION_BALANCE,
+    REGION_BET,
+    REGION_PROMPT, //prompt line, messages and echo, whatever main.c prints itself
+    NUM_REGIONS
+} UsartRegion;
+
+//transmit ring counters since power up, bytes sent trails bytes queued by what is in the ring
+typedef struct {
+    uint32_t queued; //bytes written
+    uint32_t sent; //bytes the DMA has finished with
+    uint32_t peak; //most bytes in the ring at once
+    uint32_t transfers; //DMA transfers started
+    uint32_t full_waits; //writes that found the ring full and waited for room
+    uint32_t errors; //DMA transfer errors, their bytes are lost
+} UsartTxStats;
+
+//wheel frames of the latest spin and the run time of the timer interrupt posting them, shown
+//under the transmit counters
+typedef struct {
+    IsrTiming timer; //TIM2_IRQHandler since power up
+    uint32_t posted; //frames the timer asked for
+    uint32_t drawn; //frames the main loop drew
+    uint32_t dropped; //frames skipped because the transmit backlog was over budget
+} UsartSpinStats;
 
 void USART_init(void);
+void USART_write(const char*, uint32_t);
+void USART_tx_flush(void);
+UsartTxStats USART_tx_stats(void);
+UsartRegion USART_tx_region(UsartRegion);
+void USART_tx_state(uint8_t);
+void USART_tx_input_start(void);
+uint32_t USART_tx_region_bytes(uint8_t, UsartRegion);
+void USART_open_tx_report(const char **, const UsartSpinStats *);
+void USART_close_tx_report(void);
 void USART_print_char(char);
-void USART_print_string(char*);
-void USART_ESC_Code(char*);
+void USART_print_string(const char*);
+void USART_print_number(uint32_t);
+void USART_print_currency(uint32_t);
+void USART_ESC_Code(const char*);
 void USART_reset_screen(void);
 void USART_start_screen(void);
-void USART_print_table(Spot*);
+void USART_flush_screen(void);
+void USART_paint_screen(void);
+void USART_move_cursor(uint8_t, uint8_t);
+void USART_print_table(PocketMask);
 Spot USART_print_wheel(const Spot*, uint32_t);
 void USART_print_chips(Chips*, uint32_t);
 
@@ -0,0 +1,109 @@
+//number formatting microbenchmark, runs on the build host
+//
+//compares format.c against the snprintf calls it replaced in usart.c and main.c, in cycles per
+//call over values like the ones the game prints: chip counts, bets, balances and whole range
+//numbers. every value is checked against snprintf first, a mismatch fails the run.
+//
+//build and run (from the repository root):
+//  gcc -O2 -Wall -Wextra -ICore/Src Tools/bench_format.c Core/Src/format.c -o bench_format
+//  ./bench_format
+#include "format.h"
+#include <stdio.h>
+#include <string.h>
+#include <x86intrin.h>
+
+#define NUM_VALUES 4096 //values formatted per round, power of 2
+#define ROUNDS 500 //passes over the values
+#define FIELD_WIDTH 8 //balance field of usart.c
+
+static uint32_t values[NUM_VALUES];
+static volatile char sink; //keeps the formatted text alive
+
+//xorshift32, only picks values
+static uint32_t next_random(uint32_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+//a quarter each of chip counts, bets, balances and any 32 bit value
+static void fill_values(void) {
+    static const uint32_t limits[] = {1000, 100000, 10000000, 0};
+    uint32_t state = 1;
+    for (uint32_t i = 0; i < NUM_VALUES; i++) {
+        uint32_t limit = limits[i % 4];
+        uint32_t word = next_random(&state);
+        values[i] = (limit == 0) ? word : word % limit;
+    }
+}
+
+//every formatter against snprintf on every value and the edges of the range
+static int check(void) {
+    static const uint32_t edges[] = {0, 9, 10, 99, 100, 12345678, 123456789, 4294967295u};
+    int errors = 0;
+    for (uint32_t i = 0; i < NUM_VALUES + sizeof(edges) / sizeof(edges[0]); i++) {
+        uint32_t value = (i < NUM_VALUES) ? values[i] : edges[i - NUM_VALUES];
+        char expected[32];
+        char text[FORMAT_SIZE];
+        snprintf(expected, sizeof(expected), "%lu", (unsigned long)value);
+        errors += (format_number(text, value) != strlen(expected) || strcmp(text, expected) != 0);
+        snprintf(expected, sizeof(expected), "$%lu", (unsigned long)value);
+        errors += (format_currency(text, value) != strlen(expected) || strcmp(text, expected) != 0);
+        //a value wider than the field keeps its leading digits, the first FIELD_WIDTH characters
+        snprintf(expected, sizeof(expected), "%-*lu", FIELD_WIDTH, (unsigned long)value);
+        format_field(text, value, FIELD_WIDTH, ALIGN_LEFT);
+        errors += (strlen(text) != FIELD_WIDTH || strncmp(text, expected, FIELD_WIDTH) != 0);
+        if (value < 100000000) {
+            snprintf(expected, sizeof(expected), "%*lu", FIELD_WIDTH, (unsigned long)value);
+            format_field(text, value, FIELD_WIDTH, ALIGN_RIGHT);
+            errors += (strcmp(text, expected) != 0);
+        }
+    }
+    return errors;
+}
+
+int main(void) {
+    fill_values();
+    int errors = check();
+    if (errors != 0) {
+        printf("%d values format differently from snprintf\n", errors);
+        return 1;
+    }
+    char text[32];
+    double cycles[2][3];
+    for (int kind = 0; kind < 3; kind++) {
+        uint64_t start = __rdtsc();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (uint32_t i = 0; i < NUM_VALUES; i++) {
+                switch (kind) {
+                    case 0: snprintf(text, sizeof(text), "%lu", (unsigned long)values[i]); break;
+                    case 1: snprintf(text, sizeof(text), "$%lu", (unsigned long)values[i]); break;
+                    default: snprintf(text, sizeof(text), "%-*lu", FIELD_WIDTH, (unsigned long)values[i]);
+                }
+                sink = text[0];
+            }
+        }
+        cycles[0][kind] = (double)(__rdtsc() - start) / ((double)ROUNDS * NUM_VALUES);
+        start = __rdtsc();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (uint32_t i = 0; i < NUM_VALUES; i++) {
+                switch (kind) {
+                    case 0: format_number(text, values[i]); break;
+                    case 1: format_currency(text, values[i]); break;
+                    default: format_field(text, values[i], FIELD_WIDTH, ALIGN_LEFT);
+                }
+                sink = text[0];
+            }
+        }
+        cycles[1][kind] = (double)(__rdtsc() - start) / ((double)ROUNDS * NUM_VALUES);
+    }
+    static const char *names[3] = {"number", "currency", "field of 8"};
+    printf("%-12s %14s %14s %8s\n", "text", "snprintf", "format.c", "speedup");
+    for (int kind = 0; kind < 3; kind++) {
+        printf("%-12s %14.1f %14.1f %7.1fx\n", names[kind], cycles[0][kind], cycles[1][kind],
+               cycles[0][kind] / cycles[1][kind]);
+    }
+    printf("(cycles per call, %d values)\n", NUM_VALUES);
+    return 0;
+}
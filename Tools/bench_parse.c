@@ -0,0 +1,107 @@
+//bet type parse microbenchmark, runs on the build host
+//
+//compares parse_bet_type() (generated trie) against the strcmp chain that BET_TYPE_ST
+//and calculate_odds() used before bet types became an enum, in cycles per parse.
+//
+//build and run (from the repository root):
+//  gcc -O2 -ICore/Src Tools/bench_parse.c Core/Src/bets.c Core/Src/payouts_*.c Core/Src/spots.c -o bench_parse
+//  ./bench_parse
+#include "bets.h"
+#include <stdio.h>
+#include <string.h>
+#include <x86intrin.h>
+
+#define ROUNDS 2000000 //parses per input
+
+//inputs an operator can type, including prefixes and typos
+static const char *inputs[] = {
+    "Straight", "Split", "Street", "Basket", "Corner", "Top Line", "Double Street", "Dozen",
+    "Column", "Red", "Black", "Odd", "Even", "Low", "High", "Dou", "Stra", "Col", "Blue", "S"
+};
+
+#define NUM_INPUTS (sizeof(inputs) / sizeof(inputs[0]))
+
+//bet type detection as BET_TYPE_ST did it with strcmp
+static BetType legacy_bet_type(const char *bet_type) {
+    if (strcmp(bet_type, "Straight") == 0) return BET_STRAIGHT;
+    if (strcmp(bet_type, "Split") == 0) return BET_SPLIT;
+    if (strcmp(bet_type, "Street") == 0) return BET_STREET;
+    if (strcmp(bet_type, "Basket") == 0) return BET_BASKET;
+    if (strcmp(bet_type, "Corner") == 0) return BET_CORNER;
+    if (strcmp(bet_type, "Top Line") == 0) return BET_TOP_LINE;
+    if (strcmp(bet_type, "Double Street") == 0) return BET_DOUBLE_STREET;
+    if (strcmp(bet_type, "Dozen") == 0) return BET_DOZEN;
+    if (strcmp(bet_type, "Column") == 0) return BET_COLUMN;
+    if (strcmp(bet_type, "Red") == 0 || strcmp(bet_type, "Black") == 0) {
+        return (strcmp(bet_type, "Red") == 0) ? BET_RED : BET_BLACK;
+    }
+    if (strcmp(bet_type, "Odd") == 0 || strcmp(bet_type, "Even") == 0) {
+        return (strcmp(bet_type, "Odd") == 0) ? BET_ODD : BET_EVEN;
+    }
+    if (strcmp(bet_type, "Low") == 0 || strcmp(bet_type, "High") == 0) {
+        return (strcmp(bet_type, "Low") == 0) ? BET_LOW : BET_HIGH;
+    }
+    return BET_TYPE_NONE;
+}
+
+//odds lookup as calculate_odds() did it with strcmp at resolution time
+static uint32_t legacy_odds(const char *bet_type) {
+    if (strcmp(bet_type, "Straight") == 0) return 36;
+    if (strcmp(bet_type, "Split") == 0) return 18;
+    if (strcmp(bet_type, "Street") == 0) return 12;
+    if (strcmp(bet_type, "Basket") == 0) return 12;
+    if (strcmp(bet_type, "Corner") == 0) return 9;
+    if (strcmp(bet_type, "Top Line") == 0) return 7;
+    if (strcmp(bet_type, "Double Street") == 0) return 6;
+    if (strcmp(bet_type, "Dozen") == 0 || strcmp(bet_type, "Column") == 0) return 3;
+    if (strcmp(bet_type, "Red") == 0 || strcmp(bet_type, "Black") == 0 ||
+        strcmp(bet_type, "Odd") == 0 || strcmp(bet_type, "Even") == 0 ||
+        strcmp(bet_type, "Low") == 0 || strcmp(bet_type, "High") == 0) return 2;
+    return 0;
+}
+
+int main(void) {
+    char buffers[NUM_INPUTS][20];
+    volatile uint32_t sink = 0;
+    //copy inputs into writable buffers like usart_input_buffer
+    for (size_t i = 0; i < NUM_INPUTS; i++) {
+        strncpy(buffers[i], inputs[i], sizeof(buffers[i]) - 1);
+        buffers[i][sizeof(buffers[i]) - 1] = '\0';
+    }
+    printf("%-14s %12s %12s %8s  %s\n", "input", "chain cyc", "trie cyc", "speedup", "parsed as");
+    double chain_total = 0;
+    double trie_total = 0;
+    for (size_t i = 0; i < NUM_INPUTS; i++) {
+        char *input = buffers[i];
+        //current chain: detect the type in BET_TYPE_ST, then look up odds by name
+        uint64_t start = __rdtsc();
+        for (uint32_t r = 0; r < ROUNDS; r++) {
+            __asm__ volatile("" : : "r"(input) : "memory");
+            sink += legacy_bet_type(input) + legacy_odds(input);
+        }
+        double chain = (double)(__rdtsc() - start) / ROUNDS;
+        //trie: parse once, then index by enum
+        start = __rdtsc();
+        for (uint32_t r = 0; r < ROUNDS; r++) {
+            __asm__ volatile("" : : "r"(input) : "memory");
+            BetType type = parse_bet_type(input);
+            sink += type + calculate_odds(type);
+        }
+        double trie = (double)(__rdtsc() - start) / ROUNDS;
+        BetType parsed = parse_bet_type(input);
+        printf("%-14s %12.1f %12.1f %7.1fx  %s\n", inputs[i], chain, trie, chain / trie,
+               (parsed == BET_TYPE_NONE) ? "(none)" : bet_type_names[parsed]);
+        chain_total += chain;
+        trie_total += trie;
+    }
+    printf("%-14s %12.1f %12.1f %7.1fx\n", "mean", chain_total / NUM_INPUTS, trie_total / NUM_INPUTS,
+           chain_total / trie_total);
+    //check that the trie agrees with the chain on every exact name
+    for (uint8_t t = 0; t < NUM_BET_TYPES; t++) {
+        if (parse_bet_type(bet_type_names[t]) != legacy_bet_type(bet_type_names[t])) {
+            printf("mismatch on %s\n", bet_type_names[t]);
+            return 1;
+        }
+    }
+    return (int)(sink & 0);
+}
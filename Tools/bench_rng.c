@@ -0,0 +1,144 @@
+//random word generator benchmark, runs on the build host
+//
+//checks Philox4x32-10 against the published known answers and that sim_rng_fill() gives
+//the same words as sim_rng_next(), then reports the throughput of
+//  - sim_rng_fill(): blocks of a stream computed side by side (vectorized)
+//  - sim_rng_next(): one word at a time
+//  - RNG_get_random_number() from host_rng.c: the firmware interface on the host
+//  - a model of the STM32 TRNG path: the same DRDY busy-wait as misc.c against a stand-in
+//    peripheral that has a new word every TRNG_CLOCKS_PER_WORD cycles of its 48 MHz clock
+//
+//build and run (from the repository root):
+//  gcc -O2 -ICore/Src -ITools Tools/bench_rng.c Tools/host_rng.c Tools/sim.c Core/Src/spots.c -o bench_rng
+//  ./bench_rng [words]
+#include "host_rng.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+
+#define BLOCK_WORDS 4096 //words per sim_rng_fill() call, stays in L1
+#define TRNG_CLOCK_HZ 48000000.0 //RNG kernel clock set up by RNG_init()
+#define TRNG_CLOCKS_PER_WORD 42 //RNG clocks per 32-bit word (STM32L4 reference manual)
+#define TRNG_WORDS 200000 //words read through the TRNG model
+#define RNG_SR_DRDY 0x1u //data ready flag, as in the device header
+
+//stand-in for the RNG peripheral, DRDY comes up on the time stamp counter
+typedef struct {
+    uint64_t ready_at; //TSC value when the next word is ready
+    uint64_t ticks_per_word; //TSC ticks between words
+    SimRng source; //where the stand-in's words come from
+} TrngModel;
+
+static TrngModel trng;
+
+static uint32_t trng_sr(void) {
+    return (__rdtsc() >= trng.ready_at) ? RNG_SR_DRDY : 0;
+}
+
+static uint32_t trng_dr(void) {
+    trng.ready_at = __rdtsc() + trng.ticks_per_word;
+    return sim_rng_next(&trng.source);
+}
+
+//RNG_get_random_number() from misc.c against the stand-in registers
+static uint32_t trng_get_random_number(void) {
+    //wait for the data ready flag
+    while (!(trng_sr() & RNG_SR_DRDY));
+    //return the random number
+    return trng_dr();
+}
+
+//TSC ticks per second, measured against the wall clock
+static double tsc_rate(void) {
+    double start = sim_now();
+    uint64_t ticks = __rdtsc();
+    while (sim_now() - start < 0.05);
+    return (__rdtsc() - ticks) / (sim_now() - start);
+}
+
+static void report(const char *name, uint64_t words, double seconds, double baseline) {
+    double rate = words / seconds;
+    printf("%-24s %12.1f %10.3f %12.1fx\n", name, rate / 1e6, rate * 4 / 1e9, (baseline > 0) ? rate / baseline : 1.0);
+}
+
+int main(int argc, char **argv) {
+    uint64_t words = (argc > 1) ? sim_parse_count(argv[1]) : 1000000000ULL;
+    if (words == 0) {
+        fprintf(stderr, "usage: %s [words]\n", argv[0]);
+        return 2;
+    }
+    //known answers from the Random123 distribution (kat_vectors, philox4x32 10 rounds)
+    static const uint32_t kat[3][10] = {
+        {0, 0, 0, 0, 0, 0, 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+        {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+         0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+        {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0,
+         0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}
+    };
+    for (uint8_t i = 0; i < 3; i++) {
+        uint32_t out[4];
+        sim_philox(&kat[i][0], &kat[i][4], out);
+        if (memcmp(out, &kat[i][6], sizeof(out)) != 0) {
+            printf("Philox known answer %u failed\n", i);
+            return 1;
+        }
+    }
+    //the bulk path must hand out the same words as the word at a time path
+    uint32_t block[BLOCK_WORDS];
+    uint32_t check[BLOCK_WORDS];
+    SimRng a;
+    SimRng b;
+    sim_rng_seed(&a, 7, 3);
+    sim_rng_seed(&b, 7, 3);
+    sim_rng_next(&a); //start the bulk path mid block
+    sim_rng_next(&b);
+    sim_rng_fill(&a, block, BLOCK_WORDS - 5);
+    for (uint32_t i = 0; i < BLOCK_WORDS - 5; i++) {
+        check[i] = sim_rng_next(&b);
+    }
+    if (memcmp(block, check, (BLOCK_WORDS - 5) * sizeof(uint32_t)) != 0 || sim_rng_next(&a) != sim_rng_next(&b)) {
+        printf("sim_rng_fill() and sim_rng_next() disagree\n");
+        return 1;
+    }
+    printf("known answers and fill/next agreement ok\n\n");
+
+    volatile uint32_t sink = 0;
+    printf("%-24s %12s %10s %13s\n", "path", "M words/s", "GB/s", "vs TRNG");
+    //TRNG model first, it is the baseline
+    trng.ticks_per_word = (uint64_t)(tsc_rate() * TRNG_CLOCKS_PER_WORD / TRNG_CLOCK_HZ);
+    sim_rng_seed(&trng.source, 1, 0);
+    double start = sim_now();
+    for (uint32_t i = 0; i < TRNG_WORDS; i++) {
+        sink ^= trng_get_random_number();
+    }
+    double baseline = TRNG_WORDS / (sim_now() - start);
+    report("TRNG busy-wait model", TRNG_WORDS, TRNG_WORDS / baseline, baseline);
+
+    SimRng rng;
+    sim_rng_seed(&rng, 1, 0);
+    start = sim_now();
+    for (uint64_t done = 0; done < words; done += BLOCK_WORDS) {
+        sim_rng_fill(&rng, block, BLOCK_WORDS);
+        sink ^= block[done & (BLOCK_WORDS - 1)];
+    }
+    report("sim_rng_fill", words, sim_now() - start, baseline);
+
+    start = sim_now();
+    uint32_t x = 0;
+    for (uint64_t i = 0; i < words; i++) {
+        x ^= sim_rng_next(&rng);
+    }
+    sink ^= x;
+    report("sim_rng_next", words, sim_now() - start, baseline);
+
+    host_rng_seed(1, 0);
+    start = sim_now();
+    for (uint64_t i = 0; i < words / 4; i++) {
+        x ^= RNG_get_random_number();
+    }
+    sink ^= x;
+    report("RNG_get_random_number", words / 4, sim_now() - start, baseline);
+    return (int)(sink & 0);
+}
@@ -0,0 +1,64 @@
+//spin kernel benchmark, runs on the build host
+//
+//settles one bet over the same block of random words with the scalar, AVX2 and AVX-512
+//kernels, reports spins/s for each and fails if their totals are not bit-identical.
+//
+//build and run (from the repository root):
+//  gcc -O2 -ICore/Src -ITools Tools/bench_spin.c Tools/spin_kernel.c Tools/sim.c Core/Src/spots.c Core/Src/payouts_*.c -o bench_spin
+//  ./bench_spin [spins]
+#include "spin_kernel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_WORDS (1u << 20) //random words per block, fits in L2/L3
+#define BENCH_BET BET_ID_STRAIGHT //a straight bet has the widest payout spread
+
+int main(int argc, char **argv) {
+    uint64_t spins = (argc > 1) ? sim_parse_count(argv[1]) : 500000000ULL;
+    uint32_t *words = malloc(BLOCK_WORDS * sizeof(uint32_t));
+    if (words == NULL || spins == 0) {
+        fprintf(stderr, "usage: %s [spins]\n", argv[0]);
+        return 2;
+    }
+    SimRng rng;
+    sim_rng_seed(&rng, 1, 0);
+    sim_rng_fill(&rng, words, BLOCK_WORDS);
+    int32_t pay_by_index[ARR_SIZE];
+    spin_kernel_prepare(BENCH_BET, pay_by_index);
+
+    SpinTotals reference = {0};
+    bool have_reference = false;
+    int status = 0;
+    printf("%-8s %14s %12s %14s %14s\n", "kernel", "spins/s", "speedup", "paid", "wins");
+    double scalar_rate = 0;
+    for (uint8_t k = 0; k < NUM_KERNELS; k++) {
+        if (!spin_kernel_supported((SpinKernelKind)k)) {
+            printf("%-8s %14s\n", spin_kernel_names[k], "unsupported");
+            continue;
+        }
+        SpinKernel kernel = spin_kernel_get((SpinKernelKind)k);
+        SpinTotals totals = {0};
+        double start = sim_now();
+        for (uint64_t done = 0; done < spins; done += BLOCK_WORDS) {
+            size_t count = (spins - done < BLOCK_WORDS) ? (size_t)(spins - done) : BLOCK_WORDS;
+            kernel(words, count, pay_by_index, &totals);
+        }
+        double rate = totals.spins / (sim_now() - start);
+        if (k == KERNEL_SCALAR) {
+            scalar_rate = rate;
+        }
+        printf("%-8s %14.3e %11.2fx %14llu %14llu\n", spin_kernel_names[k], rate, rate / scalar_rate,
+               (unsigned long long)totals.paid, (unsigned long long)totals.wins);
+        //every kernel must match the first one exactly
+        if (!have_reference) {
+            reference = totals;
+            have_reference = true;
+        } else if (memcmp(&reference, &totals, sizeof(totals)) != 0) {
+            printf("%s totals differ from %s\n", spin_kernel_names[k], spin_kernel_names[KERNEL_SCALAR]);
+            status = 1;
+        }
+    }
+    free(words);
+    return status;
+}
@@ -0,0 +1,194 @@
+//streaming pocket bias scan over a spin history, runs on the build host
+//
+//feeds every result through the same detector RESULT_ST runs on the device (Core/Src/bias.c)
+//in order, printing each alert with the spin that raised it, then the whole history and
+//window statistics and the hottest sector of wheel_arr. input is a result log, either pocket
+//labels as the terminal prints them ("0".."36", "00", "000", any separators) or one pocket
+//byte per spin (0-36, 37 for 00, 38 for 000). without -f the host Philox generator is scanned
+//instead, -B sending a share of its spins into the sector from wheel index -S to see how
+//soon a bias is caught.
+//
+//build and run (from the repository root):
+//  gcc -O2 -ICore/Src -ITools Tools/bias_scan.c Tools/stats.c Tools/sim.c Core/Src/bias.c Core/Src/spots.c -lm -o bias_scan
+//  ./bias_scan -n 1e6 -B 2 -S 10
+//  ./bias_scan -f results.txt
+#include "bias.h"
+#include "sim.h"
+#include "stats.h"
+#include <ctype.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_ALERTS 20 //alerts printed before the rest are only counted
+
+static BiasDetector bias;
+static uint8_t index_of_pocket[ARR_SIZE]; //wheel index of each pocket
+static uint64_t alert_counts[BIAS_ALERTS]; //alerts raised of each kind
+static uint32_t max_alerts = MAX_ALERTS;
+
+static const char *alert_names[BIAS_ALERTS] = {"pockets", "window pockets", "sector", "window sector"};
+
+//add one result and report the alerts it raised
+static void add_result(uint8_t index) {
+    uint8_t raised = bias_add(&bias, index);
+    for (uint8_t kind = 0; kind < BIAS_ALERTS; kind++) {
+        if (!(raised & (1 << kind))) {
+            continue;
+        }
+        if (alert_counts[0] + alert_counts[1] + alert_counts[2] + alert_counts[3] < max_alerts) {
+            printf("spin %10u: %-14s", bias.spins, alert_names[kind]);
+            if (kind == 0) {
+                printf(" chi-square %.2f\n", bias_chi_square(&bias));
+            } else if (kind == 1) {
+                printf(" chi-square %.2f\n", bias_window_chi_square(&bias));
+            } else if (kind == 2) {
+                printf(" from %s, z %+.2f\n", spot_labels[wheel_arr[bias.hot_sector]], bias_sector_z(&bias, bias.hot_sector));
+            } else {
+                printf(" from %s, %u of the last %u\n", spot_labels[wheel_arr[bias.hot_window_sector]],
+                       bias.window_sectors[bias.hot_window_sector], BIAS_WINDOW);
+            }
+        }
+        alert_counts[kind]++;
+    }
+}
+
+//scan a log of pocket labels or bytes
+static int scan_file(const char *path, bool text) {
+    FILE *file = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    if (file == NULL) {
+        perror(path);
+        return 2;
+    }
+    char label[4];
+    uint8_t length = 0;
+    int c;
+    while ((c = fgetc(file)) != EOF) {
+        uint8_t pocket = (uint8_t)c;
+        if (text) {
+            if (isdigit(c) && length < 3) {
+                label[length++] = (char)c;
+                continue;
+            }
+            if (length == 0) {
+                continue;
+            }
+            label[length] = '\0';
+            length = 0;
+            pocket = spot_to_pocket(label);
+        }
+        if (pocket >= ARR_SIZE) {
+            fprintf(stderr, "bias_scan: skipping a result that is not a pocket of the %s wheel\n", WHEEL_NAME);
+            continue;
+        }
+        add_result(index_of_pocket[pocket]);
+    }
+    if (text && length > 0) {
+        label[length] = '\0';
+        uint8_t pocket = spot_to_pocket(label);
+        if (pocket < ARR_SIZE) {
+            add_result(index_of_pocket[pocket]);
+        }
+    }
+    if (file != stdin) {
+        fclose(file);
+    }
+    return 0;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-f file|-] [-F text|pockets] [-n spins] [-s seed] [-B sector bias%%] [-S first index] "
+            "[-c chi limit] [-z sector limit] [-m alerts shown]\n", name);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    bool text = true;
+    uint64_t spins = 10000000;
+    uint64_t seed = 1;
+    double sector_bias = 0; //percent of spins sent into the biased sector
+    uint32_t sector_first = 0;
+    double chi_limit = BIAS_CHI_LIMIT;
+    double z_limit = BIAS_Z_LIMIT;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:F:n:s:B:S:c:z:m:")) != -1) {
+        switch (opt) {
+            case 'f': path = optarg; break;
+            case 'F':
+                if (strcmp(optarg, "text") == 0) text = true;
+                else if (strcmp(optarg, "pockets") == 0) text = false;
+                else usage(argv[0]);
+                break;
+            case 'n': spins = sim_parse_count(optarg); break;
+            case 's': seed = strtoull(optarg, NULL, 0); break;
+            case 'B': sector_bias = atof(optarg); break;
+            case 'S': sector_first = (uint32_t)atoi(optarg); break;
+            case 'c': chi_limit = atof(optarg); break;
+            case 'z': z_limit = atof(optarg); break;
+            case 'm': max_alerts = (uint32_t)atoi(optarg); break;
+            default: usage(argv[0]);
+        }
+    }
+    if (spins == 0 || spins > UINT32_MAX || sector_bias < 0 || sector_bias > 100 || sector_first >= ARR_SIZE) {
+        usage(argv[0]);
+    }
+    for (uint8_t i = 0; i < ARR_SIZE; i++) {
+        index_of_pocket[wheel_arr[i]] = i;
+    }
+    bias_init(&bias, chi_limit, z_limit);
+
+    double start = sim_now();
+    if (path != NULL) {
+        int status = scan_file(path, text);
+        if (status != 0) {
+            return status;
+        }
+    } else {
+        //a share of the spins lands anywhere in the biased sector, the rest anywhere on the wheel
+        uint32_t biased = (uint32_t)(sector_bias / 100 * 4294967295.0);
+        SimRng rng;
+        sim_rng_seed(&rng, seed, 0);
+        for (uint64_t n = 0; n < spins; n++) {
+            uint32_t word = sim_rng_next(&rng);
+            if (sim_rng_next(&rng) < biased) {
+                add_result((uint8_t)((sector_first + (((uint64_t)word * BIAS_SECTOR) >> 32)) % ARR_SIZE));
+            } else {
+                add_result(spin_index(word));
+            }
+        }
+    }
+    double elapsed = sim_now() - start;
+    if (bias.spins == 0) {
+        fprintf(stderr, "bias_scan: no results\n");
+        return 2;
+    }
+
+    uint64_t alerts = alert_counts[0] + alert_counts[1] + alert_counts[2] + alert_counts[3];
+    if (alerts > max_alerts) {
+        printf("... %llu more alerts\n", (unsigned long long)(alerts - max_alerts));
+    }
+    printf("\n%u spins of the %s wheel from %s in %.3f s (%.1f M spins/s)\n", bias.spins, WHEEL_NAME,
+           (path != NULL) ? path : "the host generator", elapsed, bias.spins / elapsed / 1e6);
+    double chi2 = bias_chi_square(&bias);
+    printf("whole history  chi-square %10.2f on %u df, p = %.4f\n", chi2, ARR_SIZE - 1, chi_square_p(chi2, ARR_SIZE - 1));
+    chi2 = bias_window_chi_square(&bias);
+    printf("last %-4u      chi-square %10.2f on %u df, p = %.4f\n", BIAS_WINDOW, chi2, ARR_SIZE - 1,
+           chi_square_p(chi2, ARR_SIZE - 1));
+    uint8_t hottest = 0;
+    for (uint8_t i = 1; i < ARR_SIZE; i++) {
+        hottest = (bias.sectors[i] > bias.sectors[hottest]) ? i : hottest;
+    }
+    double z = bias_sector_z(&bias, hottest);
+    printf("hottest sector %s", spot_labels[wheel_arr[hottest]]);
+    for (uint8_t i = 1; i < BIAS_SECTOR; i++) {
+        printf(" %s", spot_labels[wheel_arr[(hottest + i) % ARR_SIZE]]);
+    }
+    printf(", z %+.2f, p = %.4f across all %u sectors\n", z, 1 - pow(1 - (normal_p(z) / 2), ARR_SIZE), ARR_SIZE);
+    printf("alerts         %llu pockets, %llu window pockets, %llu sector, %llu window sector\n",
+           (unsigned long long)alert_counts[0], (unsigned long long)alert_counts[1],
+           (unsigned long long)alert_counts[2], (unsigned long long)alert_counts[3]);
+    return (bias.active != 0) ? 1 : 0;
+}
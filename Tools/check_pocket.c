@@ -0,0 +1,67 @@
+//pocket selection check, runs on the build host
+//
+//walks every 32-bit word through the rejection test of RNG_get_random_below(ARR_SIZE) and
+//counts the accepted words per wheel index, which must all be equal for the selection to be
+//exactly uniform, next to the same count for the old RNG_get_random_number() % ARR_SIZE.
+//then draws pockets through RNG_get_random_below() from host_rng.c and reports a
+//chi-square against the uniform distribution and how often a second word was needed.
+//
+//build and run (from the repository root):
+//  gcc -O2 -ICore/Src -ITools Tools/check_pocket.c Core/Src/random.c Tools/host_rng.c Tools/sim.c Tools/stats.c Core/Src/spots.c -lm -o check_pocket
+//  ./check_pocket [draws]
+#include "host_rng.h"
+#include "random.h"
+#include "sim.h"
+#include "stats.h"
+#include <stdio.h>
+
+int main(int argc, char **argv) {
+    uint64_t draws = (argc > 1) ? sim_parse_count(argv[1]) : 100000000ULL;
+    //every word, split into its result (high word of the product) and rejection test (low word)
+    const uint32_t threshold = (uint32_t)(-(uint32_t)ARR_SIZE % ARR_SIZE);
+    uint64_t shift_counts[ARR_SIZE] = {0};
+    uint64_t modulo_counts[ARR_SIZE] = {0};
+    uint64_t rejected = 0;
+    uint32_t word = 0;
+    do {
+        uint64_t product = (uint64_t)word * ARR_SIZE;
+        if ((uint32_t)product >= threshold) {
+            shift_counts[product >> 32]++;
+        } else {
+            rejected++;
+        }
+        modulo_counts[word % ARR_SIZE]++;
+    } while (++word != 0);
+    uint64_t shift_min = UINT64_MAX, shift_max = 0, modulo_min = UINT64_MAX, modulo_max = 0;
+    for (uint8_t i = 0; i < ARR_SIZE; i++) {
+        shift_min = (shift_counts[i] < shift_min) ? shift_counts[i] : shift_min;
+        shift_max = (shift_counts[i] > shift_max) ? shift_counts[i] : shift_max;
+        modulo_min = (modulo_counts[i] < modulo_min) ? modulo_counts[i] : modulo_min;
+        modulo_max = (modulo_counts[i] > modulo_max) ? modulo_counts[i] : modulo_max;
+    }
+    printf("all 2^32 words, words per wheel index:\n");
+    printf("  %% ARR_SIZE             min %llu max %llu\n", (unsigned long long)modulo_min,
+           (unsigned long long)modulo_max);
+    printf("  RNG_get_random_below   min %llu max %llu (%llu words rejected)\n", (unsigned long long)shift_min,
+           (unsigned long long)shift_max, (unsigned long long)rejected);
+    if (shift_min != shift_max) {
+        printf("RNG_get_random_below is not exactly uniform\n");
+        return 1;
+    }
+
+    //drawn pockets, chi-square with ARR_SIZE - 1 degrees of freedom
+    uint64_t counts[ARR_SIZE] = {0};
+    host_rng_seed(1, 0);
+    for (uint64_t i = 0; i < draws; i++) {
+        counts[RNG_get_random_below(ARR_SIZE)]++;
+    }
+    double expected = (double)draws / ARR_SIZE;
+    double chi2 = 0;
+    for (uint8_t i = 0; i < ARR_SIZE; i++) {
+        chi2 += (counts[i] - expected) * (counts[i] - expected) / expected;
+    }
+    double p = chi_square_p(chi2, ARR_SIZE - 1);
+    printf("%llu draws: chi-square %.2f on %u degrees of freedom, p-value %.4f\n",
+           (unsigned long long)draws, chi2, ARR_SIZE - 1, p);
+    return (p > 0.001) ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+//host stand-in for the STM32L4 HAL and CMSIS headers, enough to build the terminal code
+//(usart.c) on the build host. registers are plain structs owned by the host tool, which
+//points the peripheral names at them. bits and IRQ numbers are the STM32L476 ones.
+//
+//interrupts are a flag, and every write of it calls host_interrupt_point() so the tool can
+//run its DMA and raise interrupts wherever the firmware would let them in
+#ifndef HOST_STM32L4XX_HAL_H_
+#define HOST_STM32L4XX_HAL_H_
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct { volatile uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2], BRR; } GPIO_TypeDef;
+typedef struct { volatile uint32_t CR1, CR2, CR3, BRR, GTPR, RTOR, RQR, ISR, ICR, RDR, TDR; } USART_TypeDef;
+typedef struct { volatile uint32_t AHB1ENR, AHB2ENR, APB1ENR1; } RCC_TypeDef;
+typedef struct { volatile uint32_t ISER[8]; } NVIC_Type;
+typedef struct { volatile uint32_t ISR, IFCR; } DMA_TypeDef;
+//address registers hold host pointers
+typedef struct { volatile uint32_t CCR, CNDTR; volatile uintptr_t CPAR, CMAR; } DMA_Channel_TypeDef;
+typedef struct { volatile uint32_t CSELR; } DMA_Request_TypeDef;
+
+extern GPIO_TypeDef *GPIOA;
+extern USART_TypeDef *USART2;
+extern RCC_TypeDef *RCC;
+extern NVIC_Type *NVIC;
+extern DMA_TypeDef *DMA1;
+extern DMA_Channel_TypeDef *DMA1_Channel7;
+extern DMA_Request_TypeDef *DMA1_CSELR;
+
+typedef enum {
+    DMA1_Channel7_IRQn = 17,
+    TIM2_IRQn = 28,
+    USART2_IRQn = 38,
+    RNG_IRQn = 80
+} IRQn_Type;
+
+extern uint32_t host_primask;
+void host_interrupt_point(void);
+#define __get_PRIMASK() (host_primask)
+#define __set_PRIMASK(mask) ((host_primask = (mask)), host_interrupt_point())
+#define __disable_irq() __set_PRIMASK(1)
+#define __enable_irq() __set_PRIMASK(0)
+
+#define RCC_AHB1ENR_DMA1EN (1u << 0)
+#define RCC_AHB2ENR_GPIOAEN (1u << 0)
+#define RCC_APB1ENR1_USART2EN (1u << 17)
+
+#define GPIO_MODER_MODE2 (3u << 4)
+#define GPIO_MODER_MODE2_1 (2u << 4)
+#define GPIO_MODER_MODE3 (3u << 6)
+#define GPIO_MODER_MODE3_1 (2u << 6)
+#define GPIO_OTYPER_OT2 (1u << 2)
+#define GPIO_OTYPER_OT3 (1u << 3)
+#define GPIO_OSPEEDR_OSPEED2 (3u << 4)
+#define GPIO_OSPEEDR_OSPEED3 (3u << 6)
+#define GPIO_PUPDR_PUPD2 (3u << 4)
+#define GPIO_PUPDR_PUPD3 (3u << 6)
+#define GPIO_AFRL_AFSEL2_Pos 8
+#define GPIO_AFRL_AFSEL2 (0xFu << GPIO_AFRL_AFSEL2_Pos)
+#define GPIO_AFRL_AFSEL3_Pos 12
+#define GPIO_AFRL_AFSEL3 (0xFu << GPIO_AFRL_AFSEL3_Pos)
+
+#define USART_CR1_UE (1u << 0)
+#define USART_CR1_RE (1u << 2)
+#define USART_CR1_TE (1u << 3)
+#define USART_CR1_RXNEIE (1u << 5)
+#define USART_CR1_PCE (1u << 10)
+#define USART_CR1_M0 (1u << 12)
+#define USART_CR1_OVER8 (1u << 15)
+#define USART_CR1_M1 (1u << 28)
+#define USART_CR2_STOP (3u << 12)
+#define USART_CR3_DMAT (1u << 7)
+#define USART_ISR_RXNE (1u << 5)
+#define USART_ISR_TC (1u << 6)
+#define USART_ISR_TXE (1u << 7)
+
+#define DMA_CCR_EN (1u << 0)
+#define DMA_CCR_TCIE (1u << 1)
+#define DMA_CCR_HTIE (1u << 2)
+#define DMA_CCR_TEIE (1u << 3)
+#define DMA_CCR_DIR (1u << 4)
+#define DMA_CCR_CIRC (1u << 5)
+#define DMA_CCR_PINC (1u << 6)
+#define DMA_CCR_MINC (1u << 7)
+#define DMA_CCR_PSIZE (3u << 8)
+#define DMA_CCR_MSIZE (3u << 10)
+#define DMA_ISR_GIF7 (1u << 24)
+#define DMA_ISR_TCIF7 (1u << 25)
+#define DMA_ISR_HTIF7 (1u << 26)
+#define DMA_ISR_TEIF7 (1u << 27)
+#define DMA_IFCR_CGIF7 (1u << 24)
+#define DMA_IFCR_CTCIF7 (1u << 25)
+#define DMA_IFCR_CHTIF7 (1u << 26)
+#define DMA_IFCR_CTEIF7 (1u << 27)
+#define DMA_CSELR_C7S_Pos 24
+#define DMA_CSELR_C7S (0xFu << DMA_CSELR_C7S_Pos)
+
+#endif
@@ -0,0 +1,18 @@
+//host stand-in for RNG_get_random_number() in misc.c
+//
+//linked instead of misc.c when game code runs on the build host. words come from a Philox
+//stream, so a run is replayed exactly by seeding the same (seed, stream) again.
+#include "host_rng.h"
+#include "sim.h"
+
+static SimRng host_rng = {.used = 4}; //fixed stream until host_rng_seed() is called
+
+//pick the stream RNG_get_random_number() reads from
+void host_rng_seed(uint64_t seed, uint64_t stream) {
+    sim_rng_seed(&host_rng, seed, stream);
+}
+
+//generate a random number
+uint32_t RNG_get_random_number(void) {
+    return sim_rng_next(&host_rng);
+}
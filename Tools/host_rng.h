@@ -0,0 +1,8 @@
+#ifndef TOOLS_HOST_RNG_H_
+#define TOOLS_HOST_RNG_H_
+#include <stdint.h>
+
+void host_rng_seed(uint64_t, uint64_t);
+uint32_t RNG_get_random_number(void);
+
+#endif
@@ -0,0 +1,218 @@
+//check of the spin pacing in pacing.c, runs on the build host
+//
+//paces spins launched by physics.c over a range of durations and eases and checks every one:
+//the number of frames, the launch at step 0, steps that never go back, the rest reached on the
+//last frame in the landing pocket, and no frame moving the ball further than the ease allows.
+//then plays the wheel frames of spins into a model of the transmit ring and the wire, as the
+//main loop of main.c draws them, once dropping frames over the budget and once without, and
+//checks the dropping keeps every frame within the budget of wire time behind its post and
+//always shows the rest. reports the wall time of spins before and after the pacing.
+//
+//build and run (from the repository root):
+//  gcc -O2 -ICore/Src Tools/pacing_check.c Core/Src/pacing.c Core/Src/physics.c Core/Src/spots.c -o pacing_check
+//  ./pacing_check -s 1
+#include "pacing.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPINS 2000 //launches paced per duration and ease
+#define SPIN_DURATION_MS 6000 //as main.c paces a spin
+#define SPIN_EASE (PACING_EASE_FULL / 2)
+#define SPIN_TX_BUDGET 300
+#define TX_RING_SIZE 2048 //as usart.c
+#define BITS_PER_BYTE 10 //start, 8 data and stop bits
+#define FRAME_MIN 20 //bytes of a wheel frame, about the spread screen_bench measures
+#define FRAME_MAX 160
+
+static uint64_t rng_state;
+
+//xorshift64, only picks launches and frame sizes
+static uint32_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+static void launch(WheelSpin *spin) {
+    uint32_t words[PHYSICS_WORDS];
+    for (uint8_t i = 0; i < PHYSICS_WORDS; i++) {
+        words[i] = next_random();
+    }
+    physics_launch(spin, &wheel_physics, words);
+    physics_land_on(spin, next_random() % ARR_SIZE);
+}
+
+//the frames and steps of one pacing, returns the errors found
+static int check_pacing(const WheelSpin *spin, uint32_t duration_ms, uint16_t ease) {
+    SpinPacing pacing;
+    pacing_init(&pacing, spin->rest_step, duration_ms, ease);
+    uint32_t expected = (uint32_t)(((uint64_t)duration_ms * PHYSICS_FRAME_HZ) / 1000);
+    expected = (expected < PACING_MIN_FRAMES) ? PACING_MIN_FRAMES : expected;
+    uint32_t last = pacing.frames - 1;
+    uint32_t held = (ease < PACING_EASE_FULL) ? ease : PACING_EASE_FULL;
+    //the fastest frame, at the launch, moves 1 + e times the even pace, rounding adds a step
+    uint64_t most = (((uint64_t)spin->rest_step * (PACING_EASE_FULL + held)) / ((uint64_t)last * PACING_EASE_FULL)) + 1;
+    int errors = 0;
+    errors += (pacing.frames != expected);
+    errors += (pacing_step(&pacing, 0) != 0);
+    errors += (pacing_step(&pacing, last) != spin->rest_step);
+    errors += (pacing_step(&pacing, last + 100) != spin->rest_step);
+    errors += (physics_index_at(spin, pacing_step(&pacing, last)) != spin->landing_index);
+    for (uint32_t frame = 1; frame <= last; frame++) {
+        uint32_t before = pacing_step(&pacing, frame - 1);
+        uint32_t step = pacing_step(&pacing, frame);
+        errors += (step < before || step - before > most);
+        errors += (frame < last && step >= spin->rest_step && spin->rest_step > 0); //no early rest
+    }
+    return errors;
+}
+
+//wheel frames of a spin played into the transmit ring, times in milliseconds
+typedef struct {
+    uint32_t drawn;
+    uint32_t dropped; //over the budget
+    uint32_t merged; //posted while the main loop was held by a full ring, only the latest is drawn
+    double worst_lag; //longest from a frame's post to its last byte on the wire
+    double rest_lag; //the same for the last frame
+    bool rest_drawn;
+} WireRun;
+
+//a frame the main loop takes at time now, posted at its frame time
+static void draw_frame(WireRun *run, uint32_t frame, uint32_t last, double now, double period, double byte_ms,
+                       bool drop, double *wire_free, double *writer_free) {
+    double backlog = (*wire_free > now) ? (*wire_free - now) / byte_ms : 0;
+    if (drop && !pacing_draw((uint32_t)backlog, SPIN_TX_BUDGET, frame == last)) {
+        run->dropped++;
+        return;
+    }
+    uint32_t bytes = FRAME_MIN + (next_random() % (FRAME_MAX - FRAME_MIN + 1));
+    *wire_free = ((*wire_free > now) ? *wire_free : now) + (bytes * byte_ms);
+    //the write waits for room in the ring, the main loop takes no frame until it returns
+    double room = *wire_free - (TX_RING_SIZE * byte_ms);
+    *writer_free = (room > now) ? room : now;
+    double lag = *wire_free - (frame * period);
+    run->worst_lag = (lag > run->worst_lag) ? lag : run->worst_lag;
+    run->rest_lag = lag;
+    run->rest_drawn = (frame == last);
+    run->drawn++;
+}
+
+//frames posted at the frame rate from the launch, burst bytes already queued ahead of them
+static WireRun run_wire(const SpinPacing *pacing, uint32_t baud, uint32_t burst, bool drop) {
+    WireRun run = {0};
+    double byte_ms = 1000.0 * BITS_PER_BYTE / baud;
+    double period = 1000.0 / PHYSICS_FRAME_HZ;
+    double wire_free = burst * byte_ms; //the wire is idle from then
+    double writer_free = (burst > TX_RING_SIZE) ? (burst - TX_RING_SIZE) * byte_ms : 0;
+    uint32_t last = pacing->frames - 1;
+    uint32_t pending = 0; //frame posted and not yet taken
+    for (uint32_t frame = 1; frame <= last; frame++) {
+        double now = frame * period;
+        if (pending != 0 && writer_free <= now) {
+            draw_frame(&run, pending, last, writer_free, period, byte_ms, drop, &wire_free, &writer_free);
+            pending = 0;
+        }
+        if (writer_free > now) {
+            run.merged += (pending != 0);
+            pending = frame;
+            continue;
+        }
+        draw_frame(&run, frame, last, now, period, byte_ms, drop, &wire_free, &writer_free);
+    }
+    if (pending != 0) {
+        draw_frame(&run, pending, last, writer_free, period, byte_ms, drop, &wire_free, &writer_free);
+    }
+    return run;
+}
+
+int main(int argc, char **argv) {
+    rng_state = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            rng_state = strtoull(argv[++i], NULL, 0) | 1;
+        } else {
+            fprintf(stderr, "usage: %s [-s seed]\n", argv[0]);
+            return 2;
+        }
+    }
+    static const uint32_t durations[] = {0, 30, 1000, SPIN_DURATION_MS, 20000};
+    static const uint16_t eases[] = {0, PACING_EASE_FULL / 4, SPIN_EASE, PACING_EASE_FULL, 1000};
+    int failures = 0;
+
+    int errors = 0;
+    for (uint8_t d = 0; d < sizeof(durations) / sizeof(durations[0]); d++) {
+        for (uint8_t e = 0; e < sizeof(eases) / sizeof(eases[0]); e++) {
+            for (uint32_t n = 0; n < SPINS; n++) {
+                WheelSpin spin;
+                launch(&spin);
+                errors += check_pacing(&spin, durations[d], eases[e]);
+            }
+        }
+    }
+    printf("%s: pacing of %u spins over %zu durations and %zu eases (%d errors)\n", errors ? "FAIL" : "PASS",
+           SPINS, sizeof(durations) / sizeof(durations[0]), sizeof(eases) / sizeof(eases[0]), errors);
+    failures += (errors != 0);
+
+    //wall time of a spin, the physics shown at PHYSICS_STEPS_PER_FRAME steps a frame as before
+    double shortest = 1e9;
+    double longest = 0;
+    double total = 0;
+    for (uint32_t n = 0; n < SPINS; n++) {
+        WheelSpin spin;
+        launch(&spin);
+        double seconds = (double)spin.rest_step / PHYSICS_STEP_HZ;
+        shortest = (seconds < shortest) ? seconds : shortest;
+        longest = (seconds > longest) ? seconds : longest;
+        total += seconds;
+    }
+    SpinPacing paced;
+    pacing_init(&paced, 0, SPIN_DURATION_MS, SPIN_EASE);
+    printf("spin wall time: physics pace %.2f-%.2f s (mean %.2f), paced %.2f s in %u frames\n", shortest, longest,
+           total / SPINS, (double)paced.frames / PHYSICS_FRAME_HZ, paced.frames);
+
+    //a quiet link, one with a burst queued at the launch (a screen still painting, typed echo)
+    //and a slow terminal the frames cannot keep up with
+    static const struct {
+        uint32_t baud;
+        uint32_t burst;
+    } links[] = {{115200, 0}, {115200, 2 * TX_RING_SIZE}, {9600, 0}};
+    printf("\n%-8s %6s %-5s %7s %8s %7s %11s %10s\n", "baud", "burst", "drop", "drawn", "dropped", "merged",
+           "worst lag", "rest lag");
+    for (uint8_t l = 0; l < sizeof(links) / sizeof(links[0]); l++) {
+        for (uint8_t drop = 0; drop < 2; drop++) {
+            WireRun worst = {0};
+            uint64_t drawn = 0;
+            uint64_t dropped = 0;
+            uint64_t merged = 0;
+            errors = 0;
+            for (uint32_t n = 0; n < SPINS; n++) {
+                WheelSpin spin;
+                launch(&spin);
+                SpinPacing pacing;
+                pacing_init(&pacing, spin.rest_step, SPIN_DURATION_MS, SPIN_EASE);
+                WireRun run = run_wire(&pacing, links[l].baud, links[l].burst, drop);
+                drawn += run.drawn;
+                dropped += run.dropped;
+                merged += run.merged;
+                worst.worst_lag = (run.worst_lag > worst.worst_lag) ? run.worst_lag : worst.worst_lag;
+                worst.rest_lag = (run.rest_lag > worst.rest_lag) ? run.rest_lag : worst.rest_lag;
+                errors += !run.rest_drawn;
+                if (drop) {
+                    //past the burst a frame waits at most the budget and the frame before it
+                    double byte_ms = 1000.0 * BITS_PER_BYTE / links[l].baud;
+                    double bound = (SPIN_TX_BUDGET + (2 * FRAME_MAX)) * byte_ms;
+                    errors += (run.rest_lag > bound);
+                    errors += (links[l].burst == 0 && run.worst_lag > bound);
+                }
+            }
+            printf("%-8u %6u %-5s %7.1f %8.1f %7.1f %8.1f ms %7.1f ms  %s\n", links[l].baud, links[l].burst,
+                   drop ? "yes" : "no", (double)drawn / SPINS, (double)dropped / SPINS, (double)merged / SPINS,
+                   worst.worst_lag, worst.rest_lag, errors ? "FAIL" : "PASS");
+            failures += (errors != 0);
+        }
+    }
+    printf("(frames per spin, worst lag of any spin from a frame's post to its last byte on the wire)\n");
+    return (failures != 0);
+}
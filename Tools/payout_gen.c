@@ -0,0 +1,532 @@
+//payout matrix generator, runs on the build host before the firmware is compiled
+//
+//turns the bet tables and calculate_odds() rules in spots.c into payouts_<wheel>.h/.c:
+//one bet ID per table row and, per bet ID, the payout multiplier of every pocket.
+//every table row is checked against the layout first, a bad row fails the build.
+//also emits the trie that parse_bet_type() walks to turn typed names into a BetType, and
+//the screen cell and print order of every spot on the table.
+//
+//run once per wheel variant, each run writes its own pair of files (compiled only when
+//WHEEL_ZEROS matches) and the shared payouts.h that picks between them.
+//
+//build and run (from the repository root):
+//  for zeros in 1 2 3; do
+//    gcc -O2 -Wall -Wextra -DWHEEL_ZEROS=$zeros -ICore/Src Tools/payout_gen.c Core/Src/spots.c -o payout_gen && ./payout_gen Core/Src
+//  done
+#include "spots.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_ROW_SIZE 18 //largest bet covers 18 pockets
+#define MAX_TRIE_NODES 255 //trie indexes are stored in a byte
+#define TABLE_TOP_ROW 13 //screen row of the 3rd row of numbers
+#define TABLE_LEFT_COL 6 //screen column of the first column of numbers
+#define TABLE_ROW_HEIGHT 2 //screen rows from one row of numbers to the next
+#define TABLE_CELL_WIDTH 5 //screen columns from one column of numbers to the next
+#define ZERO_LABEL_END 4 //screen column after the zero labels
+
+#if WHEEL_ZEROS == 1
+#define VARIANT "single" //output file suffix
+#define VARIANT_UPPER "SINGLE" //output include guard
+#elif WHEEL_ZEROS == 2
+#define VARIANT "double"
+#define VARIANT_UPPER "DOUBLE"
+#else
+#define VARIANT "triple"
+#define VARIANT_UPPER "TRIPLE"
+#endif
+
+//screen position of a spot on the table, as written to payouts.h
+typedef struct {
+    uint8_t row; //screen row, 1 based
+    uint8_t col; //screen column of the first character of the label, 1 based
+} TableCell;
+
+//structure to represent one bet table from spots.c
+typedef struct {
+    const char *id_name; //name of the first bet ID macro
+    BetType bet_type; //bet type of every row
+    const char **cells; //first cell of the table
+    uint8_t rows; //number of bets in the table
+    uint8_t cols; //number of pockets per bet
+    bool (*valid)(const uint8_t *, uint8_t); //layout rule for one row
+} BetTable;
+
+//table column (0-11) of a number on the layout
+static int layout_col(uint8_t pocket) {
+    return (pocket - 1) / 3;
+}
+
+//table row (0-2) of a number on the layout
+static int layout_row(uint8_t pocket) {
+    return (pocket - 1) % 3;
+}
+
+static bool is_zero(uint8_t pocket) {
+    return pocket == 0 || pocket > 36;
+}
+
+//place of a zero in the zero column, counted from the 1st row up (0, 000, 00)
+static int zero_slot(uint8_t pocket) {
+    return (pocket == 0) ? 0 : (pocket == POCKET_000) ? 1 : WHEEL_ZEROS - 1;
+}
+
+//first and last table row (0-2) beside a zero, the zeros share the three rows evenly
+static int zero_first_row(uint8_t pocket) {
+    return (zero_slot(pocket) * 3) / WHEEL_ZEROS;
+}
+
+static int zero_last_row(uint8_t pocket) {
+    return (((zero_slot(pocket) + 1) * 3) - 1) / WHEEL_ZEROS;
+}
+
+//check if two pockets share an edge on the layout
+static bool adjacent(uint8_t a, uint8_t b) {
+    if (is_zero(a) && is_zero(b)) {
+        return abs(zero_slot(a) - zero_slot(b)) == 1; //zeros stacked in one column
+    }
+    if (is_zero(b)) {
+        uint8_t t = a;
+        a = b;
+        b = t;
+    }
+    if (is_zero(a)) {
+        //a zero borders the 1st column of numbers along the rows it spans
+        return layout_col(b) == 0 && layout_row(b) >= zero_first_row(a) && layout_row(b) <= zero_last_row(a);
+    }
+    return abs(layout_col(a) - layout_col(b)) + abs(layout_row(a) - layout_row(b)) == 1;
+}
+
+//check that a row covers a block of whole columns and rows of the layout
+static bool is_block(const uint8_t *pockets, uint8_t count, int width, int height) {
+    int min_col = 12;
+    int min_row = 3;
+    for (uint8_t i = 0; i < count; i++) {
+        if (is_zero(pockets[i])) {
+            return false;
+        }
+        if (layout_col(pockets[i]) < min_col) min_col = layout_col(pockets[i]);
+        if (layout_row(pockets[i]) < min_row) min_row = layout_row(pockets[i]);
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (layout_col(pockets[i]) >= min_col + width || layout_row(pockets[i]) >= min_row + height) {
+            return false;
+        }
+    }
+    return count == width * height;
+}
+
+static bool valid_straight(const uint8_t *pockets, uint8_t count) {
+    (void)pockets; //any single pocket is a straight, the signature is the validator table's
+    return count == 1;
+}
+
+static bool valid_split(const uint8_t *pockets, uint8_t count) {
+    return count == 2 && adjacent(pockets[0], pockets[1]);
+}
+
+static bool valid_street(const uint8_t *pockets, uint8_t count) {
+    return is_block(pockets, count, 1, 3);
+}
+
+//a basket is three pockets around the zeros that all touch each other, or the three zeros
+static bool valid_basket(const uint8_t *pockets, uint8_t count) {
+    bool has_zero = false;
+    bool all_zero = true;
+    bool touching = true;
+    for (uint8_t i = 0; i < count; i++) {
+        has_zero |= is_zero(pockets[i]);
+        all_zero &= is_zero(pockets[i]);
+        for (uint8_t j = i + 1; j < count; j++) {
+            touching &= adjacent(pockets[i], pockets[j]);
+        }
+    }
+    return count == 3 && has_zero && (touching || all_zero);
+}
+
+static bool valid_corner(const uint8_t *pockets, uint8_t count) {
+    return is_block(pockets, count, 2, 2);
+}
+
+//the top line is every zero and the first street
+static bool valid_top_line(const uint8_t *pockets, uint8_t count) {
+    PocketMask mask = 0;
+    PocketMask expected = POCKET_BIT(1) | POCKET_BIT(2) | POCKET_BIT(3);
+    for (uint8_t i = 0; i < count; i++) {
+        mask |= POCKET_BIT(pockets[i]);
+    }
+    for (uint8_t p = 0; p < ARR_SIZE; p++) {
+        expected |= is_zero(p) ? POCKET_BIT(p) : 0;
+    }
+    return mask == expected;
+}
+
+static bool valid_double_street(const uint8_t *pockets, uint8_t count) {
+    return is_block(pockets, count, 2, 3);
+}
+
+static bool valid_dozen(const uint8_t *pockets, uint8_t count) {
+    return is_block(pockets, count, 4, 3);
+}
+
+static bool valid_column(const uint8_t *pockets, uint8_t count) {
+    return is_block(pockets, count, 12, 1);
+}
+
+//check every pocket of the row against the color printed on the table
+static bool valid_color(const uint8_t *pockets, uint8_t count, SpotColor color) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (spot_colors[pockets[i]] != color) {
+            return false;
+        }
+    }
+    return count == 18;
+}
+
+static bool valid_red(const uint8_t *pockets, uint8_t count) {
+    return valid_color(pockets, count, SPOT_RED);
+}
+
+static bool valid_black(const uint8_t *pockets, uint8_t count) {
+    return valid_color(pockets, count, SPOT_BLACK);
+}
+
+//check that every pocket is a non-zero number with the given property
+static bool valid_parity_or_half(const uint8_t *pockets, uint8_t count, int kind) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (is_zero(pockets[i])) {
+            return false;
+        }
+        bool ok = (kind == 0) ? (pockets[i] % 2 == 1)
+                : (kind == 1) ? (pockets[i] % 2 == 0)
+                : (kind == 2) ? (pockets[i] <= 18)
+                : (pockets[i] >= 19);
+        if (!ok) {
+            return false;
+        }
+    }
+    return count == 18;
+}
+
+static bool valid_odd(const uint8_t *pockets, uint8_t count) {
+    return valid_parity_or_half(pockets, count, 0);
+}
+
+static bool valid_even(const uint8_t *pockets, uint8_t count) {
+    return valid_parity_or_half(pockets, count, 1);
+}
+
+static bool valid_low(const uint8_t *pockets, uint8_t count) {
+    return valid_parity_or_half(pockets, count, 2);
+}
+
+static bool valid_high(const uint8_t *pockets, uint8_t count) {
+    return valid_parity_or_half(pockets, count, 3);
+}
+
+//one straight bet per pocket, in pocket index order
+static const char *straight_cells[ARR_SIZE] = {
+    "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12",
+    "13", "14", "15", "16", "17", "18", "19", "20", "21", "22", "23", "24",
+    "25", "26", "27", "28", "29", "30", "31", "32", "33", "34", "35", "36",
+#if WHEEL_ZEROS >= 2
+    "00",
+#endif
+#if WHEEL_ZEROS == 3
+    "000"
+#endif
+};
+
+static const BetTable bet_tables[] = {
+    {"BET_ID_STRAIGHT", BET_STRAIGHT, straight_cells, ARR_SIZE, 1, valid_straight},
+    {"BET_ID_SPLIT", BET_SPLIT, &split_bets[0][0], NUM_SPLITS, SPLIT_SIZE, valid_split},
+    {"BET_ID_STREET", BET_STREET, &street_bets[0][0], 12, ST_SIZE, valid_street},
+    {"BET_ID_BASKET", BET_BASKET, &basket_bets[0][0], NUM_BASKETS, BASKET_SIZE, valid_basket},
+    {"BET_ID_CORNER", BET_CORNER, &corner_bets[0][0], 22, CORNER_SIZE, valid_corner},
+    {"BET_ID_TOP_LINE", BET_TOP_LINE, top_line, 1, TOP_LINE_SIZE, valid_top_line},
+    {"BET_ID_DOUBLE_STREET", BET_DOUBLE_STREET, &double_street_bets[0][0], 11, DUB_ST_SIZE, valid_double_street},
+    {"BET_ID_DOZEN", BET_DOZEN, &dozen_bets[0][0], 3, DOZ_COL_SIZE, valid_dozen},
+    {"BET_ID_COLUMN", BET_COLUMN, &column_bets[0][0], 3, DOZ_COL_SIZE, valid_column},
+    {"BET_ID_RED", BET_RED, red, 1, 18, valid_red},
+    {"BET_ID_BLACK", BET_BLACK, black, 1, 18, valid_black},
+    {"BET_ID_ODD", BET_ODD, odds, 1, 18, valid_odd},
+    {"BET_ID_EVEN", BET_EVEN, evens, 1, 18, valid_even},
+    {"BET_ID_LOW", BET_LOW, low_half, 1, 18, valid_low},
+    {"BET_ID_HIGH", BET_HIGH, high_half, 1, 18, valid_high}
+};
+
+#define NUM_TABLES (uint8_t)(sizeof(bet_tables) / sizeof(bet_tables[0]))
+
+//structure to represent a trie node while it is built
+typedef struct {
+    char c; //character leading into the node
+    uint8_t first_child; //index of the first child, 0 if none
+    uint8_t next_sibling; //index of the next sibling, 0 if none
+    uint8_t bet_type; //bet type spelled by the path to this node
+    uint8_t completion; //only bet type below this node
+} TrieNode;
+
+static TrieNode trie[MAX_TRIE_NODES];
+static uint8_t trie_size = 1; //node 0 is the root
+
+//add a bet type name to the trie
+static void trie_insert(const char *name, uint8_t bet_type) {
+    uint8_t node = 0;
+    for (; *name != '\0'; name++) {
+        uint8_t child = trie[node].first_child;
+        uint8_t last = 0;
+        while (child != 0 && trie[child].c != *name) {
+            last = child;
+            child = trie[child].next_sibling;
+        }
+        if (child == 0) {
+            if (trie_size == MAX_TRIE_NODES) {
+                fprintf(stderr, "payout_gen: bet type names do not fit in the trie\n");
+                exit(1);
+            }
+            child = trie_size++;
+            trie[child] = (TrieNode) {*name, 0, 0, BET_TYPE_NONE, BET_TYPE_NONE};
+            if (last == 0) {
+                trie[node].first_child = child;
+            } else {
+                trie[last].next_sibling = child;
+            }
+        }
+        node = child;
+    }
+    trie[node].bet_type = bet_type;
+}
+
+//count the bet types at or below a node and record the completion if there is one
+static uint8_t trie_complete(uint8_t node) {
+    uint8_t count = (trie[node].bet_type != BET_TYPE_NONE) ? 1 : 0;
+    uint8_t only = trie[node].bet_type;
+    for (uint8_t child = trie[node].first_child; child != 0; child = trie[child].next_sibling) {
+        uint8_t below = trie_complete(child);
+        if (below == 1 && count == 0) {
+            only = trie[child].completion;
+        }
+        count += below;
+    }
+    trie[node].completion = (count == 1) ? only : BET_TYPE_NONE;
+    return count;
+}
+
+//print a trie character as a C character literal
+static void print_char_literal(FILE *file, char c) {
+    if (c == '\0') {
+        fprintf(file, "'\\0'");
+    } else {
+        fprintf(file, "'%c'", c);
+    }
+}
+
+//open an output file inside the output directory
+static FILE *open_output(const char *dir, const char *name) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "payout_gen: cannot write %s\n", path);
+        exit(1);
+    }
+    return file;
+}
+
+int main(int argc, char **argv) {
+    const char *out_dir = (argc > 1) ? argv[1] : ".";
+    static uint8_t payouts[256][ARR_SIZE];
+    static PocketMask masks[256];
+    uint16_t first_id[NUM_TABLES + 1];
+    uint16_t num_ids = 0;
+    int errors = 0;
+
+    //validate every table row and fill its matrix row
+    for (uint8_t t = 0; t < NUM_TABLES; t++) {
+        const BetTable *table = &bet_tables[t];
+        const char *type_name = bet_type_names[table->bet_type];
+        uint32_t odds = calculate_odds(table->bet_type);
+        if (table->bet_type != t) {
+            fprintf(stderr, "payout_gen: %s table is out of BetType order\n", type_name);
+            errors++;
+        }
+        if (odds == 0 || odds > UINT8_MAX) {
+            fprintf(stderr, "payout_gen: no odds for bet type \"%s\"\n", type_name);
+            errors++;
+        }
+        first_id[t] = num_ids;
+        for (uint8_t r = 0; r < table->rows; r++) {
+            const char **row = table->cells + (r * table->cols);
+            uint8_t pockets[MAX_ROW_SIZE];
+            PocketMask mask = 0;
+            bool ok = true;
+            for (uint8_t c = 0; c < table->cols; c++) {
+                pockets[c] = spot_to_pocket(row[c]);
+                if (pockets[c] == POCKET_INVALID || (mask & POCKET_BIT(pockets[c]))) {
+                    ok = false; //not a pocket, or listed twice
+                    break;
+                }
+                mask |= POCKET_BIT(pockets[c]);
+            }
+            if (!ok || !table->valid(pockets, table->cols)) {
+                fprintf(stderr, "payout_gen: %s bet %u is not valid on the layout:", type_name, r + 1);
+                for (uint8_t c = 0; c < table->cols; c++) {
+                    fprintf(stderr, " %s", row[c]);
+                }
+                fprintf(stderr, "\n");
+                errors++;
+                continue;
+            }
+            masks[num_ids] = mask;
+            for (uint8_t p = 0; p < ARR_SIZE; p++) {
+                payouts[num_ids][p] = (mask & POCKET_BIT(p)) ? (uint8_t)odds : 0;
+            }
+            num_ids++;
+        }
+    }
+    first_id[NUM_TABLES] = num_ids;
+    if (NUM_TABLES != NUM_BET_TYPES) {
+        fprintf(stderr, "payout_gen: expected one table per bet type\n");
+        errors++;
+    }
+    if (errors > 0) {
+        fprintf(stderr, "payout_gen: %d error(s), nothing written\n", errors);
+        return 1;
+    }
+
+    //build the bet type name trie
+    trie[0] = (TrieNode) {'\0', 0, 0, BET_TYPE_NONE, BET_TYPE_NONE};
+    for (uint8_t t = 0; t < NUM_BET_TYPES; t++) {
+        trie_insert(bet_type_names[t], t);
+    }
+    trie_complete(0);
+
+    //screen cell of every spot on the table, a zero sits beside the middle of the rows it
+    //spans, rounded away from the 2nd row
+    TableCell cells[ARR_SIZE];
+    for (uint8_t p = 0; p < ARR_SIZE; p++) {
+        if (is_zero(p)) {
+            int row = (zero_first_row(p) + zero_last_row(p) + (zero_first_row(p) > 0)) / 2;
+            cells[p].row = (uint8_t)(TABLE_TOP_ROW + ((2 - row) * TABLE_ROW_HEIGHT));
+            cells[p].col = (uint8_t)(ZERO_LABEL_END - strlen(spot_labels[p]));
+        } else {
+            cells[p].row = (uint8_t)(TABLE_TOP_ROW + ((2 - layout_row(p)) * TABLE_ROW_HEIGHT));
+            cells[p].col = (uint8_t)(TABLE_LEFT_COL + (layout_col(p) * TABLE_CELL_WIDTH));
+        }
+    }
+    //print order, top row first and left to right so the cursor only moves forward
+    Spot print_order[ARR_SIZE];
+    for (uint8_t p = 0; p < ARR_SIZE; p++) {
+        uint8_t i = p;
+        while (i > 0 && ((cells[print_order[i - 1]].row > cells[p].row) ||
+                         (cells[print_order[i - 1]].row == cells[p].row && cells[print_order[i - 1]].col > cells[p].col))) {
+            print_order[i] = print_order[i - 1];
+            i--;
+        }
+        print_order[i] = p;
+    }
+
+    //shared header, picks the bet IDs of the wheel being built
+    FILE *common = open_output(out_dir, "payouts.h");
+    fprintf(common, "//generated by Tools/payout_gen.c from the tables in spots.c, do not edit\n");
+    fprintf(common, "#ifndef SRC_PAYOUTS_H_\n#define SRC_PAYOUTS_H_\n#include \"spots.h\"\n\n");
+    fprintf(common, "//bet ID ranges of the wheel being built\n");
+    fprintf(common, "#if WHEEL_ZEROS == 1\n#include \"payouts_single.h\"\n");
+    fprintf(common, "#elif WHEEL_ZEROS == 2\n#include \"payouts_double.h\"\n");
+    fprintf(common, "#else\n#include \"payouts_triple.h\"\n#endif\n\n");
+    fprintf(common, "//node of the bet type name trie, node 0 is the root\n");
+    fprintf(common, "typedef struct {\n");
+    fprintf(common, "    char c; //character leading into the node\n");
+    fprintf(common, "    uint8_t first_child; //index of the first child, 0 if none\n");
+    fprintf(common, "    uint8_t next_sibling; //index of the next sibling, 0 if none\n");
+    fprintf(common, "    uint8_t bet_type; //bet type spelled by the path to this node, BET_TYPE_NONE if none\n");
+    fprintf(common, "    uint8_t completion; //only bet type below this node, BET_TYPE_NONE if several\n");
+    fprintf(common, "} BetTrieNode;\n\n");
+    fprintf(common, "//screen position of a spot on the table\n");
+    fprintf(common, "typedef struct {\n");
+    fprintf(common, "    uint8_t row; //screen row, 1 based\n");
+    fprintf(common, "    uint8_t col; //screen column of the first character of the label, 1 based\n");
+    fprintf(common, "} TableCell;\n\n");
+    fprintf(common, "extern const uint8_t payout_matrix[NUM_BET_IDS][ARR_SIZE];\n");
+    fprintf(common, "extern const PocketMask bet_pockets[NUM_BET_IDS];\n");
+    fprintf(common, "extern const uint8_t bet_type_first_id[NUM_BET_TYPES + 1];\n");
+    fprintf(common, "extern const BetTrieNode bet_type_trie[BET_TRIE_SIZE];\n");
+    fprintf(common, "extern const TableCell table_cells[ARR_SIZE];\n");
+    fprintf(common, "extern const Spot base_table_arr[ARR_SIZE];\n\n#endif\n");
+    fclose(common);
+
+    //header with the bet ID ranges of this wheel
+    FILE *header = open_output(out_dir, "payouts_" VARIANT ".h");
+    fprintf(header, "//generated by Tools/payout_gen.c from the tables in spots.c (%s wheel), do not edit\n", WHEEL_NAME);
+    fprintf(header, "#ifndef SRC_PAYOUTS_%s_H_\n#define SRC_PAYOUTS_%s_H_\n\n", VARIANT_UPPER, VARIANT_UPPER);
+    for (uint8_t t = 0; t < NUM_TABLES; t++) {
+        fprintf(header, "#define %s %u //first of %u %s bet(s)\n", bet_tables[t].id_name, first_id[t],
+                bet_tables[t].rows, bet_type_names[bet_tables[t].bet_type]);
+    }
+    fprintf(header, "#define NUM_BET_IDS %u //total bet IDs\n", num_ids);
+    fprintf(header, "#define BET_TRIE_SIZE %u //nodes in the bet type name trie\n\n#endif\n", trie_size);
+    fclose(header);
+
+    //source with the matrix and masks, both const so they stay in flash, compiled only for
+    //this wheel
+    FILE *source = open_output(out_dir, "payouts_" VARIANT ".c");
+    fprintf(source, "//generated by Tools/payout_gen.c from the tables in spots.c (%s wheel), do not edit\n", WHEEL_NAME);
+    fprintf(source, "#include \"payouts.h\"\n\n#if WHEEL_ZEROS == %u\n\n", WHEEL_ZEROS);
+    fprintf(source, "//payout multiplier (stake included) of every pocket, per bet ID\n");
+    fprintf(source, "const uint8_t payout_matrix[NUM_BET_IDS][ARR_SIZE] = {\n");
+    uint8_t t = 0;
+    for (uint16_t id = 0; id < num_ids; id++) {
+        while (t + 1 < NUM_TABLES && id >= first_id[t + 1]) {
+            t++;
+        }
+        if (id == first_id[t]) {
+            fprintf(source, "    //%s\n", bet_type_names[bet_tables[t].bet_type]);
+        }
+        fprintf(source, "    {");
+        for (uint8_t p = 0; p < ARR_SIZE; p++) {
+            fprintf(source, "%u%s", payouts[id][p], (p + 1 < ARR_SIZE) ? "," : "");
+        }
+        fprintf(source, "}%s\n", (id + 1 < num_ids) ? "," : "");
+    }
+    fprintf(source, "};\n\n");
+    fprintf(source, "//pockets covered by each bet ID\n");
+    fprintf(source, "const PocketMask bet_pockets[NUM_BET_IDS] = {\n");
+    for (uint16_t id = 0; id < num_ids; id++) {
+        fprintf(source, "%s0x%010llXULL%s", (id % 4 == 0) ? "    " : "", (unsigned long long)masks[id],
+                (id + 1 < num_ids) ? ((id % 4 == 3) ? ",\n" : ", ") : "\n");
+    }
+    fprintf(source, "};\n\n");
+    fprintf(source, "//first bet ID of each bet type, the last entry is NUM_BET_IDS\n");
+    fprintf(source, "const uint8_t bet_type_first_id[NUM_BET_TYPES + 1] = {\n    ");
+    for (uint8_t t = 0; t <= NUM_TABLES; t++) {
+        fprintf(source, "%u%s", first_id[t], (t < NUM_TABLES) ? ", " : "\n");
+    }
+    fprintf(source, "};\n\n");
+    fprintf(source, "//bet type name trie {c, first_child, next_sibling, bet_type, completion}\n");
+    fprintf(source, "const BetTrieNode bet_type_trie[BET_TRIE_SIZE] = {\n");
+    for (uint8_t n = 0; n < trie_size; n++) {
+        fprintf(source, "    {");
+        print_char_literal(source, trie[n].c);
+        fprintf(source, ", %u, %u, %u, %u}%s\n", trie[n].first_child, trie[n].next_sibling,
+                trie[n].bet_type, trie[n].completion, (n + 1 < trie_size) ? "," : "");
+    }
+    fprintf(source, "};\n\n");
+    fprintf(source, "//screen cell of each spot on the table {row, col}\n");
+    fprintf(source, "const TableCell table_cells[ARR_SIZE] = {\n");
+    for (uint8_t p = 0; p < ARR_SIZE; p++) {
+        fprintf(source, "%s{%u, %u}%s", (p % 8 == 0) ? "    " : "", cells[p].row, cells[p].col,
+                (p + 1 < ARR_SIZE) ? ((p % 8 == 7) ? ",\n" : ", ") : "\n");
+    }
+    fprintf(source, "};\n\n");
+    fprintf(source, "//table spots, in print order\n");
+    fprintf(source, "const Spot base_table_arr[ARR_SIZE] = {\n");
+    for (uint8_t i = 0; i < ARR_SIZE; i++) {
+        fprintf(source, "%s%u%s", (i % 13 == 0) ? "    " : "", print_order[i],
+                (i + 1 < ARR_SIZE) ? ((i % 13 == 12) ? ",\n" : ", ") : "\n");
+    }
+    fprintf(source, "};\n\n#endif\n");
+    fclose(source);
+    return 0;
+}
@@ -0,0 +1,198 @@
+//ball and rotor physics study, runs on the build host
+//
+//launches spins through the same fixed point model the device animates (Core/Src/physics.c)
+//and counts where they land. with a uniform launch the wheel stays fair whatever the tilt,
+//rotor or deflectors do, so the interesting number is where the ball lands against the pocket
+//under it as it leaves the track, the neighbours of wheel_arr a visual player would aim at.
+//spins are cut into fixed shards run across all cores and merged in order, so the counts are
+//the same for any thread count. -w fits every spin to a drawn winning index as the device does.
+//
+//build and run (from the repository root):
+//  gcc -O2 -pthread -ICore/Src -ITools Tools/physics_sim.c Tools/stats.c Tools/sim.c Core/Src/physics.c Core/Src/spots.c -lm -o physics_sim
+//  ./physics_sim -n 1e8 -T 5 -A 90 -r 2 -d 20 -p 360
+#include "physics.h"
+#include "sim.h"
+#include "stats.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SHARD_SPINS (1u << 20) //spins per shard
+#define FILL_SPINS 1024 //spins drawn from the generator at a time
+#define SECTOR_POCKETS 9 //neighbours in the sector a visual player bets
+
+//run settings shared by every shard
+typedef struct {
+    WheelPhysics model; //wheel and dealer
+    uint64_t spins; //spins of the whole run
+    uint64_t seed; //seed of the run, shard n reads stream n
+    bool fit; //fit each spin to a drawn winning index like the device
+} PhysicsRun;
+
+//counts of one shard or of the whole run
+typedef struct {
+    uint64_t spins; //spins counted
+    uint64_t steps; //steps from launch to rest, summed
+    uint64_t landings[ARR_SIZE]; //spins per landing wheel index
+    uint64_t offsets[ARR_SIZE]; //spins per wheel_arr distance from the drop index to the landing index
+    uint64_t drops[NUM_DEFLECTORS]; //spins leaving the track nearest each deflector
+    uint64_t deflections[NUM_DEFLECTORS]; //spins per deflector struck
+} PhysicsCounts;
+
+static PhysicsCounts totals; //counts of the whole run, merged in shard order
+
+//launch the spins of one shard
+static void run_shard(void *ctx, uint64_t shard, void *slot) {
+    const PhysicsRun *run = ctx;
+    PhysicsCounts *counts = slot;
+    uint64_t first = shard * SHARD_SPINS;
+    uint32_t count = (run->spins - first < SHARD_SPINS) ? (uint32_t)(run->spins - first) : SHARD_SPINS;
+    uint32_t words[FILL_SPINS * (PHYSICS_WORDS + 1)];
+    SimRng rng;
+    sim_rng_seed(&rng, run->seed, shard);
+    memset(counts, 0, sizeof(PhysicsCounts));
+    for (uint32_t done = 0; done < count; done += FILL_SPINS) {
+        uint32_t block = (count - done < FILL_SPINS) ? count - done : FILL_SPINS;
+        sim_rng_fill(&rng, words, (size_t)block * (PHYSICS_WORDS + 1));
+        for (uint32_t i = 0; i < block; i++) {
+            const uint32_t *launch = &words[i * (PHYSICS_WORDS + 1)];
+            WheelSpin spin;
+            physics_launch(&spin, &run->model, launch);
+            if (run->fit) {
+                physics_land_on(&spin, spin_index(launch[PHYSICS_WORDS]));
+            }
+            counts->steps += spin.rest_step;
+            counts->landings[spin.landing_index]++;
+            counts->offsets[(spin.landing_index + ARR_SIZE - spin.drop_index) % ARR_SIZE]++;
+            counts->drops[((uint64_t)(uint32_t)(spin.drop_angle + (0x80000000u / NUM_DEFLECTORS)) * NUM_DEFLECTORS) >> 32]++;
+            if (spin.deflector != NO_DEFLECTOR) {
+                counts->deflections[spin.deflector]++;
+            }
+        }
+    }
+    counts->spins = count;
+}
+
+//fold a finished shard into the run counts
+static void merge_shard(void *ctx, uint64_t shard, void *slot) {
+    (void)ctx;
+    (void)shard;
+    const PhysicsCounts *counts = slot;
+    totals.spins += counts->spins;
+    totals.steps += counts->steps;
+    for (uint8_t i = 0; i < ARR_SIZE; i++) {
+        totals.landings[i] += counts->landings[i];
+        totals.offsets[i] += counts->offsets[i];
+    }
+    for (uint8_t i = 0; i < NUM_DEFLECTORS; i++) {
+        totals.drops[i] += counts->drops[i];
+        totals.deflections[i] += counts->deflections[i];
+    }
+}
+
+//chi-square of counts against a uniform spread
+static double uniform_chi_square(const uint64_t *counts, uint32_t bins, uint64_t total) {
+    double expected = (double)total / bins;
+    double chi2 = 0;
+    for (uint32_t i = 0; i < bins; i++) {
+        double difference = counts[i] - expected;
+        chi2 += difference * difference / expected;
+    }
+    return chi2;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-n spins] [-t threads] [-s seed] [-T tilt%%] [-A tilt angle] [-r rotor spread%%] "
+            "[-d deflector 0 bias%%] [-p launch spread degrees] [-w]\n", name);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    PhysicsRun run = {wheel_physics, 100000000, 1, false};
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t threads = (cores > 0) ? (uint32_t)cores : 1;
+    double tilt = 0; //percent of the drop speed
+    double tilt_angle = 0; //degrees
+    double rotor_spread = 100.0 * wheel_physics.rotor_spread / wheel_physics.rotor_speed; //percent of the rotor speed
+    double bias = 0; //percent
+    double launch_spread = 360; //degrees
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:s:T:A:r:d:p:w")) != -1) {
+        switch (opt) {
+            case 'n': run.spins = sim_parse_count(optarg); break;
+            case 't': threads = (uint32_t)atoi(optarg); break;
+            case 's': run.seed = strtoull(optarg, NULL, 0); break;
+            case 'T': tilt = atof(optarg); break;
+            case 'A': tilt_angle = atof(optarg); break;
+            case 'r': rotor_spread = atof(optarg); break;
+            case 'd': bias = atof(optarg); break;
+            case 'p': launch_spread = atof(optarg); break;
+            case 'w': run.fit = true; break;
+            default: usage(argv[0]);
+        }
+    }
+    if (run.spins == 0 || threads == 0 || tilt < 0 || tilt >= 100 || rotor_spread < 0 || rotor_spread >= 100
+        || bias < 0 || bias > 100 || launch_spread < 0 || launch_spread > 360) {
+        usage(argv[0]);
+    }
+    run.model.tilt = (int32_t)(run.model.drop_speed * tilt / 100);
+    run.model.tilt_angle = (uint32_t)(int64_t)llround(fmod(tilt_angle, 360) / 360 * 4294967296.0);
+    run.model.rotor_spread = (int32_t)(run.model.rotor_speed * rotor_spread / 100);
+    run.model.deflector_bias = (uint32_t)(bias / 100 * 65536);
+    run.model.launch_spread = (uint32_t)(launch_spread / 360 * 65536);
+
+    double start = sim_now();
+    uint64_t shards = (run.spins + SHARD_SPINS - 1) / SHARD_SPINS;
+    if (sim_run_shards(threads, shards, run_shard, merge_shard, &run, sizeof(PhysicsCounts)) != 0) {
+        fprintf(stderr, "physics_sim: cannot start threads\n");
+        return 1;
+    }
+    double elapsed = sim_now() - start;
+
+    printf("%llu spins of the %s wheel on %u thread(s) in %.3f s (%.1f M spins/s, seed %llu)\n",
+           (unsigned long long)totals.spins, WHEEL_NAME, threads, elapsed, totals.spins / elapsed / 1e6,
+           (unsigned long long)run.seed);
+    printf("tilt %.1f%% at %.0f deg, rotor speed +-%.1f%%, deflector 0 bias +%.1f%%, launch spread %.0f deg%s\n",
+           tilt, tilt_angle, rotor_spread, bias, launch_spread, run.fit ? ", fitted to drawn indexes" : "");
+    printf("mean spin %.2f s from launch to rest\n\n", (double)totals.steps / totals.spins / PHYSICS_STEP_HZ);
+
+    double chi2 = uniform_chi_square(totals.landings, ARR_SIZE, totals.spins);
+    printf("landing index  chi-square %10.2f on %u df, p = %.4f\n", chi2, ARR_SIZE - 1, chi_square_p(chi2, ARR_SIZE - 1));
+    chi2 = uniform_chi_square(totals.drops, NUM_DEFLECTORS, totals.spins);
+    printf("drop point     chi-square %10.2f on %u df, p = %.4f\n\n", chi2, NUM_DEFLECTORS - 1,
+           chi_square_p(chi2, NUM_DEFLECTORS - 1));
+    printf("%-10s %10s %10s %10s\n", "deflector", "angle", "drops", "strikes");
+    for (uint8_t i = 0; i < NUM_DEFLECTORS; i++) {
+        printf("%-10u %10u %9.3f%% %9.3f%%\n", i, i * 360 / NUM_DEFLECTORS, 100.0 * totals.drops[i] / totals.spins,
+               100.0 * totals.deflections[i] / totals.spins);
+    }
+
+    //a sector of neighbours pays when it catches more than its share of landings
+    printf("\nlanding against the pocket under the ball at the drop, in wheel_arr places\n");
+    printf("%-8s %10s %10s\n", "offset", "share", "excess");
+    uint64_t best = 0;
+    uint8_t best_first = 0;
+    for (uint8_t i = 0; i < ARR_SIZE; i++) {
+        double share = (double)totals.offsets[i] / totals.spins;
+        printf("%+6d   %9.3f%% %+9.1f%%\n", (i <= ARR_SIZE / 2) ? i : i - ARR_SIZE, 100 * share, 100 * ((share * ARR_SIZE) - 1));
+        uint64_t sector = 0;
+        for (uint8_t j = 0; j < SECTOR_POCKETS; j++) {
+            sector += totals.offsets[(i + j) % ARR_SIZE];
+        }
+        if (sector > best) {
+            best = sector;
+            best_first = i;
+        }
+    }
+    double fair = (double)SECTOR_POCKETS / ARR_SIZE;
+    double rate = (double)best / totals.spins;
+    double z = (rate - fair) / sqrt(fair * (1 - fair) / totals.spins);
+    printf("\nbest %u pocket sector from offset %+d hits %.3f%% against a fair %.3f%% (z %+.1f), %+.2f%% edge on straight bets\n",
+           SECTOR_POCKETS, (best_first <= ARR_SIZE / 2) ? best_first : best_first - ARR_SIZE, 100 * rate, 100 * fair, z,
+           100 * ((rate * 36 / SECTOR_POCKETS) - 1));
+    return 0;
+}
@@ -0,0 +1,117 @@
+//check of the pocket mask bet path against the old string path, runs on the build host
+//
+//for every row of every bet table in spots.c and every pocket of the wheel, resolves the bet
+//the way the firmware did before pocket masks, by comparing the winning spot's label with each
+//number of the row with strcmp and paying calculate_odds() on a match, and the way it does now,
+//through bet_pockets, payout_matrix and a bet slip holding only that bet. every pair must agree.
+//also checks that a straight bet typed as a zero the wheel does not have, or as a number with a
+//leading zero, is refused rather than taken for another pocket.
+//
+//build and run (from the repository root):
+//  for zeros in 1 2 3; do
+//    gcc -O2 -Wall -Wextra -DWHEEL_ZEROS=$zeros -ICore/Src Tools/pocket_mask_check.c Core/Src/spots.c Core/Src/bets.c Core/Src/payouts_*.c -o pocket_mask_check && ./pocket_mask_check
+//  done
+#include "bets.h"
+#include <stdio.h>
+#include <string.h>
+
+#define STAKE 7 //amount of the slip bet, any stake the payouts are whole multiples of
+
+//a bet table of spots.c, rows of count numbers laid out one after another
+typedef struct {
+    const char **numbers;
+    uint8_t rows;
+    uint8_t count; //numbers in a row
+} BetTable;
+
+//number text of a pocket as the old path compared it, the label without its padding
+static const char *pocket_text(uint8_t pocket) {
+    const char *label = spot_labels[pocket];
+    return label + (label[0] == ' ' ? 1 : 0);
+}
+
+//what the old path returned for a bet on the row when the pocket wins
+static uint32_t string_payout(BetType type, const char **row, uint8_t count, uint8_t pocket) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (strcmp(row[i], pocket_text(pocket)) == 0) {
+            return STAKE * calculate_odds(type);
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    //straight bets had the typed number as their only row, one per pocket
+    const char *straights[ARR_SIZE];
+    for (uint8_t pocket = 0; pocket < ARR_SIZE; pocket++) {
+        straights[pocket] = pocket_text(pocket);
+    }
+    const BetTable tables[NUM_BET_TYPES] = {
+        [BET_STRAIGHT] = {straights, ARR_SIZE, 1},
+        [BET_SPLIT] = {split_bets[0], NUM_SPLITS, SPLIT_SIZE},
+        [BET_STREET] = {street_bets[0], 12, ST_SIZE},
+        [BET_BASKET] = {basket_bets[0], NUM_BASKETS, BASKET_SIZE},
+        [BET_CORNER] = {corner_bets[0], 22, CORNER_SIZE},
+        [BET_TOP_LINE] = {top_line, 1, TOP_LINE_SIZE},
+        [BET_DOUBLE_STREET] = {double_street_bets[0], 11, DUB_ST_SIZE},
+        [BET_DOZEN] = {dozen_bets[0], 3, DOZ_COL_SIZE},
+        [BET_COLUMN] = {column_bets[0], 3, DOZ_COL_SIZE},
+        [BET_RED] = {red, 1, 18},
+        [BET_BLACK] = {black, 1, 18},
+        [BET_ODD] = {odds, 1, 18},
+        [BET_EVEN] = {evens, 1, 18},
+        [BET_LOW] = {low_half, 1, 18},
+        [BET_HIGH] = {high_half, 1, 18}
+    };
+    uint32_t cases = 0;
+    uint32_t errors = 0;
+    static const char *const refused[] = {
+#if WHEEL_ZEROS < 2
+        "00",
+#endif
+#if WHEEL_ZEROS < 3
+        "000",
+#endif
+        "01", "07", "036", "37", "", "x"
+    };
+    for (uint8_t i = 0; i < sizeof(refused) / sizeof(refused[0]); i++) {
+        uint8_t pocket = spot_to_pocket(refused[i]);
+        cases++;
+        if (pocket != POCKET_INVALID) {
+            printf("straight bet \"%s\" taken for pocket %s\n", refused[i], pocket_text(pocket));
+            errors++;
+        }
+    }
+    for (uint8_t type = 0; type < NUM_BET_TYPES; type++) {
+        const BetTable *table = &tables[type];
+        uint8_t ids = bet_type_first_id[type + 1] - bet_type_first_id[type];
+        if (ids != table->rows) {
+            printf("%s: %u bet IDs for %u table rows\n", bet_type_names[type], ids, table->rows);
+            errors++;
+            continue;
+        }
+        for (uint8_t row = 0; row < table->rows; row++) {
+            uint8_t bet_id = bet_type_first_id[type] + row;
+            BetSlip slip;
+            bet_slip_clear(&slip);
+            bet_slip_add(&slip, bet_id, STAKE);
+            for (uint8_t pocket = 0; pocket < ARR_SIZE; pocket++) {
+                uint32_t expected = string_payout(type, table->numbers + (row * table->count), table->count, pocket);
+                uint32_t matrix = STAKE * payout_matrix[bet_id][pocket];
+                uint32_t resolved = bet_slip_resolve(&slip, pocket);
+                bool covered = (bet_pockets[bet_id] & POCKET_BIT(pocket)) != 0;
+                cases++;
+                if (matrix != expected || resolved != expected || covered != (expected != 0)) {
+                    if (errors++ < 10) {
+                        printf("%s row %u pocket %s: strings pay %u, matrix %u, slip %u, mask %s\n",
+                               bet_type_names[type], row + 1, pocket_text(pocket), expected, matrix, resolved,
+                               covered ? "covers" : "misses");
+                    }
+                }
+            }
+        }
+    }
+    printf("%s: %s wheel, %u bet IDs against %u pockets, %u cases (%u errors)\n", errors ? "FAIL" : "PASS",
+           WHEEL_NAME, NUM_BET_IDS, ARR_SIZE, cases, errors);
+    return (errors != 0);
+}
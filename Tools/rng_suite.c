@@ -0,0 +1,195 @@
+//RNG and pocket distribution test suite, runs on the build host
+//
+//streams pockets or raw RNG words through the tests in rng_tests.c a block at a time, so
+//captures of any size run in fixed memory. input is one of
+//  - words: raw 32-bit little endian RNG_get_random_number() words, mapped to pockets as
+//    SPIN_ST maps them
+//  - pockets: one byte per spin, the pocket number (0-36, 37 for 00, 38 for 000)
+//  - text: pocket labels as the terminal prints them ("0".."36", "00", "000"), any separators
+//and without -f the host Philox generator is tested instead, shard n reading stream n.
+//each block read is cut into fixed shards tested across all cores and merged in stream
+//order, so the result is the same for any thread count.
+//
+//build and run (from the repository root):
+//  gcc -O2 -pthread -ICore/Src -ITools Tools/rng_suite.c Tools/rng_tests.c Tools/stats.c Tools/sim.c Core/Src/spots.c -lm -o rng_suite
+//  ./rng_suite -n 1e9 -s 1
+//  ./rng_suite -f capture.bin -F words
+#include "rng_tests.h"
+#include "sim.h"
+#include <ctype.h>
+#include <getopt.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SHARD_BYTES (1u << 20) //input bytes per shard
+#define READ_BYTES (64u * SHARD_BYTES) //bytes read per block
+#define FILL_WORDS 16384 //host generator words drawn at a time
+
+typedef enum {
+    INPUT_WORDS,
+    INPUT_POCKETS,
+    INPUT_TEXT
+} InputFormat;
+
+//samples being tested, either a block of input or the host generator
+typedef struct {
+    InputFormat format; //words or pockets, text is parsed to pockets first
+    const void *data; //block of input, NULL for the host generator
+    uint64_t count; //samples of the block or of the whole generated stream
+    uint64_t seed; //seed of the host generator
+} ShardInput;
+
+static PocketTests tests; //counts of the whole stream, merged in shard order
+
+//samples per shard
+static size_t shard_samples(InputFormat format) {
+    return (format == INPUT_WORDS) ? SHARD_BYTES / sizeof(uint32_t) : SHARD_BYTES;
+}
+
+//test the samples of one shard
+static void run_shard(void *ctx, uint64_t shard, void *slot) {
+    const ShardInput *input = ctx;
+    PocketTests *out = slot;
+    uint64_t first = shard * shard_samples(input->format);
+    size_t count = (input->count - first < shard_samples(input->format)) ? (size_t)(input->count - first) : shard_samples(input->format);
+    pocket_tests_init(out);
+    if (input->data == NULL) {
+        uint32_t words[FILL_WORDS];
+        SimRng rng;
+        sim_rng_seed(&rng, input->seed, shard);
+        for (size_t done = 0; done < count; done += FILL_WORDS) {
+            size_t block = (count - done < FILL_WORDS) ? count - done : FILL_WORDS;
+            sim_rng_fill(&rng, words, block);
+            pocket_tests_add_words(out, words, block);
+        }
+    } else if (input->format == INPUT_WORDS) {
+        pocket_tests_add_words(out, (const uint32_t *)input->data + first, count);
+    } else {
+        pocket_tests_add_pockets(out, (const uint8_t *)input->data + first, count);
+    }
+}
+
+//fold a finished shard into the stream counts
+static void merge_shard(void *ctx, uint64_t shard, void *slot) {
+    (void)ctx;
+    (void)shard;
+    pocket_tests_merge(&tests, slot);
+}
+
+//test a block of samples across the threads
+static bool test_block(uint32_t threads, ShardInput *input) {
+    uint64_t shards = (input->count + shard_samples(input->format) - 1) / shard_samples(input->format);
+    return sim_run_shards(threads, shards, run_shard, merge_shard, input, sizeof(PocketTests)) == 0;
+}
+
+//pocket labels from text, a label cut by the end of a block is carried into the next one
+static size_t parse_text(const char *text, size_t length, char *label, uint8_t *label_length, bool last, uint8_t *pockets) {
+    size_t count = 0;
+    for (size_t i = 0; i <= length; i++) {
+        bool digit = (i < length) && isdigit((unsigned char)text[i]);
+        if (digit && *label_length < 3) {
+            label[(*label_length)++] = text[i];
+        } else if (!digit && *label_length > 0 && (i < length || last)) {
+            label[*label_length] = '\0';
+            uint8_t pocket = spot_to_pocket(label);
+            if (pocket == POCKET_INVALID) {
+                fprintf(stderr, "rng_suite: skipping \"%s\"\n", label);
+            } else {
+                pockets[count++] = pocket;
+            }
+            *label_length = 0;
+        }
+    }
+    return count;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-f file|-] [-F words|pockets|text] [-n count] [-s seed] [-t threads]\n", name);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    InputFormat format = INPUT_WORDS;
+    uint64_t count = 1000000000ULL;
+    uint64_t seed = 1;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t threads = (cores > 0) ? (uint32_t)cores : 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:F:n:s:t:")) != -1) {
+        switch (opt) {
+            case 'f': path = optarg; break;
+            case 'F':
+                if (strcmp(optarg, "words") == 0) format = INPUT_WORDS;
+                else if (strcmp(optarg, "pockets") == 0) format = INPUT_POCKETS;
+                else if (strcmp(optarg, "text") == 0) format = INPUT_TEXT;
+                else usage(argv[0]);
+                break;
+            case 'n': count = sim_parse_count(optarg); break;
+            case 's': seed = strtoull(optarg, NULL, 0); break;
+            case 't': threads = (uint32_t)atoi(optarg); break;
+            default: usage(argv[0]);
+        }
+    }
+    if (threads == 0) {
+        usage(argv[0]);
+    }
+    pocket_tests_init(&tests);
+    bool started = true;
+    uint64_t bytes = 0;
+    double start = sim_now();
+    if (path == NULL) {
+        ShardInput input = {INPUT_WORDS, NULL, count, seed};
+        started = test_block(threads, &input);
+        bytes = count * sizeof(uint32_t);
+        printf("host Philox streams, seed %llu\n", (unsigned long long)seed);
+    } else {
+        FILE *file = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+        char *buffer = malloc(READ_BYTES);
+        uint8_t *pockets = (format == INPUT_TEXT) ? malloc(READ_BYTES) : NULL;
+        if (file == NULL || buffer == NULL || (format == INPUT_TEXT && pockets == NULL)) {
+            perror(path);
+            return 2;
+        }
+        char label[4];
+        uint8_t label_length = 0;
+        size_t carry = 0; //bytes of a word cut by the end of a block
+        size_t read;
+        while (started && (read = fread(buffer + carry, 1, READ_BYTES - carry, file)) > 0) {
+            size_t have = carry + read;
+            bytes += read;
+            ShardInput input = {format, buffer, have, 0};
+            if (format == INPUT_WORDS) {
+                input.count = have / sizeof(uint32_t);
+                carry = have - (input.count * sizeof(uint32_t));
+            } else if (format == INPUT_TEXT) {
+                input.format = INPUT_POCKETS;
+                input.data = pockets;
+                input.count = parse_text(buffer, have, label, &label_length, false, pockets);
+            }
+            started = test_block(threads, &input);
+            memmove(buffer, buffer + have - carry, carry);
+        }
+        if (format == INPUT_TEXT) {
+            ShardInput input = {INPUT_POCKETS, pockets, parse_text("", 0, label, &label_length, true, pockets), 0};
+            started = started && test_block(threads, &input);
+        }
+        if (file != stdin) {
+            fclose(file);
+        }
+        free(buffer);
+        free(pockets);
+        printf("%s\n", path);
+    }
+    if (!started) {
+        fprintf(stderr, "rng_suite: cannot start threads\n");
+        return 2;
+    }
+    double elapsed = sim_now() - start;
+    printf("%.2f s on %u thread(s), %.1f M samples/s, %.2f GB/s\n", elapsed, threads, tests.count / elapsed / 1e6,
+           bytes / elapsed / 1e9);
+    return (pocket_tests_report(&tests) == 0) ? 0 : 1;
+}
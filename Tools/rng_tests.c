@@ -0,0 +1,259 @@
+//pocket stream quality tests for the host tools
+//
+//every test keeps counts only, fed a block of pockets at a time, so a stream of any length
+//runs in fixed memory at close to the speed the counts can be updated:
+//  - frequency: chi-square of the pocket counts
+//  - serial: overlapping pairs of consecutive pockets (Good's serial statistic)
+//  - runs: runs of low and high pockets against the number expected for a fair coin
+//  - gap: pockets between repeats of the same pocket against the geometric distribution
+//  - wheel adjacency: wheel_arr distance from one pocket to the next, uniform if fair
+//  - monobit: set bits of the raw words, when fed words
+#include "rng_tests.h"
+#include "stats.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+//start empty
+void pocket_tests_init(PocketTests *tests) {
+    memset(tests, 0, sizeof(PocketTests));
+    tests->first = POCKET_INVALID;
+    tests->previous = POCKET_INVALID;
+}
+
+//gap class of the pockets between two sightings
+static uint8_t gap_class(uint64_t from, uint64_t to) {
+    uint64_t gap = (to - from - 1) / GAP_WIDTH;
+    return (gap < GAP_CLASSES - 1) ? (uint8_t)gap : GAP_CLASSES - 1;
+}
+
+//add pocket numbers, anything out of range is skipped
+void pocket_tests_add_pockets(PocketTests *tests, const uint8_t *pockets, size_t count) {
+    size_t i = 0;
+    uint64_t position = tests->count;
+    uint8_t previous = tests->previous;
+    //the first pocket of the stream has no pair
+    while (previous == POCKET_INVALID && i < count) {
+        if (pockets[i] < ARR_SIZE) {
+            previous = pockets[i];
+            tests->first = previous;
+            tests->first_seen[previous] = ++position;
+            tests->last_seen[previous] = position;
+        }
+        i++;
+    }
+    for (; i < count; i++) {
+        uint8_t pocket = pockets[i];
+        if (pocket >= ARR_SIZE) {
+            continue;
+        }
+        position++;
+        tests->pairs[previous][pocket]++;
+        uint64_t last = tests->last_seen[pocket];
+        if (last != 0) {
+            tests->gaps[gap_class(last, position)]++;
+        } else {
+            tests->first_seen[pocket] = position;
+        }
+        tests->last_seen[pocket] = position;
+        previous = pocket;
+    }
+    tests->count = position;
+    tests->previous = previous;
+}
+
+//set bits over a block of words
+__attribute__((target_clones("popcnt", "default")))
+static uint64_t count_ones(const uint32_t *words, size_t count) {
+    uint64_t ones = 0;
+    for (size_t i = 0; i < count; i++) {
+        ones += (uint64_t)__builtin_popcount(words[i]);
+    }
+    return ones;
+}
+
+//add raw RNG words, mapped to pockets the way SPIN_ST maps them (RNG_get_random_below
+//then wheel_arr), a word the rejection step would throw away is dropped
+void pocket_tests_add_words(PocketTests *tests, const uint32_t *words, size_t count) {
+    const uint32_t threshold = (uint32_t)(-(uint32_t)ARR_SIZE % ARR_SIZE);
+    uint8_t pockets[4096];
+    size_t done = 0;
+    while (done < count) {
+        size_t block = (count - done < sizeof(pockets)) ? count - done : sizeof(pockets);
+        //rejected words are about 6 in 2^32, map the block straight and only compact it
+        //again if it holds one
+        uint32_t lowest = UINT32_MAX;
+        for (size_t i = 0; i < block; i++) {
+            uint64_t product = (uint64_t)words[done + i] * ARR_SIZE;
+            pockets[i] = (uint8_t)(product >> 32);
+            lowest = ((uint32_t)product < lowest) ? (uint32_t)product : lowest;
+        }
+        size_t kept = block;
+        if (lowest < threshold) {
+            kept = 0;
+            for (size_t i = 0; i < block; i++) {
+                pockets[kept] = pockets[i];
+                kept += ((uint32_t)((uint64_t)words[done + i] * ARR_SIZE) >= threshold);
+            }
+        }
+        for (size_t i = 0; i < kept; i++) {
+            pockets[i] = wheel_arr[pockets[i]];
+        }
+        tests->ones += count_ones(words + done, block);
+        tests->words += block;
+        tests->rejected += block - kept;
+        pocket_tests_add_pockets(tests, pockets, kept);
+        done += block;
+    }
+}
+
+//fold the counts of the stream segment that follows dst into dst
+void pocket_tests_merge(PocketTests *dst, const PocketTests *src) {
+    if (src->count == 0) {
+        return;
+    }
+    if (dst->count == 0) {
+        uint64_t words = dst->words + src->words;
+        uint64_t ones = dst->ones + src->ones;
+        uint64_t rejected = dst->rejected + src->rejected;
+        *dst = *src;
+        dst->words = words;
+        dst->ones = ones;
+        dst->rejected = rejected;
+        return;
+    }
+    //the pair across the join, then the gaps that span it
+    dst->pairs[dst->previous][src->first]++;
+    for (uint8_t a = 0; a < ARR_SIZE; a++) {
+        for (uint8_t b = 0; b < ARR_SIZE; b++) {
+            dst->pairs[a][b] += src->pairs[a][b];
+        }
+    }
+    for (uint8_t k = 0; k < GAP_CLASSES; k++) {
+        dst->gaps[k] += src->gaps[k];
+    }
+    for (uint8_t p = 0; p < ARR_SIZE; p++) {
+        if (src->first_seen[p] == 0) {
+            continue;
+        }
+        if (dst->last_seen[p] != 0) {
+            dst->gaps[gap_class(dst->last_seen[p], dst->count + src->first_seen[p])]++;
+        } else {
+            dst->first_seen[p] = dst->count + src->first_seen[p];
+        }
+        dst->last_seen[p] = dst->count + src->last_seen[p];
+    }
+    dst->count += src->count;
+    dst->previous = src->previous;
+    dst->words += src->words;
+    dst->ones += src->ones;
+    dst->rejected += src->rejected;
+}
+
+//chi-square of counts against expected counts
+static double chi_square(const uint64_t *observed, const double *expected, uint32_t classes) {
+    double chi2 = 0;
+    for (uint32_t i = 0; i < classes; i++) {
+        double d = observed[i] - expected[i];
+        chi2 += d * d / expected[i];
+    }
+    return chi2;
+}
+
+//print one result line, returns 1 if the test failed
+static uint8_t report_line(const char *name, const char *statistic, double value, double df, double p) {
+    bool failed = (p < RNG_TEST_ALPHA) || (p > 1 - RNG_TEST_ALPHA);
+    if (df > 0) {
+        printf("%-16s %-12s %14.3f %8.0f %12.6f  %s\n", name, statistic, value, df, p, failed ? "FAIL" : "pass");
+    } else {
+        printf("%-16s %-12s %14.3f %8s %12.6f  %s\n", name, statistic, value, "", p, failed ? "FAIL" : "pass");
+    }
+    return failed;
+}
+
+//print every test, returns the number that failed
+uint8_t pocket_tests_report(const PocketTests *tests) {
+    uint64_t n = tests->count;
+    uint8_t failed = 0;
+    if (n < 2) {
+        printf("not enough pockets to test\n");
+        return 1;
+    }
+    printf("%llu pockets", (unsigned long long)n);
+    if (tests->words > 0) {
+        printf(" from %llu words (%llu rejected)", (unsigned long long)tests->words,
+               (unsigned long long)tests->rejected);
+    }
+    printf("\n\n%-16s %-12s %14s %8s %12s\n", "test", "statistic", "value", "df", "p-value");
+
+    //pocket counts, wheel steps and runs from the pair counts
+    uint8_t position[ARR_SIZE];
+    for (uint8_t i = 0; i < ARR_SIZE; i++) {
+        position[wheel_arr[i]] = i;
+    }
+    uint64_t freq[ARR_SIZE] = {0};
+    uint64_t wheel_steps[ARR_SIZE] = {0};
+    uint64_t runs = 1;
+    freq[tests->first]++;
+    for (uint8_t a = 0; a < ARR_SIZE; a++) {
+        for (uint8_t b = 0; b < ARR_SIZE; b++) {
+            freq[b] += tests->pairs[a][b];
+            wheel_steps[(position[b] + ARR_SIZE - position[a]) % ARR_SIZE] += tests->pairs[a][b];
+            runs += ((a < RUN_SPLIT) != (b < RUN_SPLIT)) ? tests->pairs[a][b] : 0;
+        }
+    }
+
+    //frequency
+    double expected[ARR_SIZE * ARR_SIZE];
+    for (uint32_t i = 0; i < ARR_SIZE; i++) {
+        expected[i] = (double)n / ARR_SIZE;
+    }
+    double freq_chi2 = chi_square(freq, expected, ARR_SIZE);
+    failed += report_line("frequency", "chi-square", freq_chi2, ARR_SIZE - 1, chi_square_p(freq_chi2, ARR_SIZE - 1));
+
+    //serial pairs, the pair statistic less the single statistic removes the pocket bias
+    for (uint32_t i = 0; i < ARR_SIZE * ARR_SIZE; i++) {
+        expected[i] = (double)(n - 1) / (ARR_SIZE * ARR_SIZE);
+    }
+    double pair_chi2 = chi_square(&tests->pairs[0][0], expected, ARR_SIZE * ARR_SIZE);
+    double serial = pair_chi2 - freq_chi2;
+    double serial_df = (ARR_SIZE * ARR_SIZE) - ARR_SIZE;
+    failed += report_line("serial pairs", "Good's psi2", serial, serial_df, chi_square_p(serial, serial_df));
+
+    //runs of low and high pockets, each change after the first pocket has probability 1/2
+    double runs_z = ((double)runs - 1 - ((n - 1) / 2.0)) / sqrt((n - 1) / 4.0);
+    failed += report_line("runs low/high", "z", runs_z, 0, normal_p(runs_z));
+
+    //gaps between repeats, P(gap in class k) from the geometric distribution
+    double q = 1.0 - (1.0 / ARR_SIZE);
+    uint64_t gap_total = 0;
+    for (uint32_t k = 0; k < GAP_CLASSES; k++) {
+        gap_total += tests->gaps[k];
+    }
+    for (uint32_t k = 0; k < GAP_CLASSES; k++) {
+        double from = pow(q, (double)k * GAP_WIDTH);
+        double to = (k == GAP_CLASSES - 1) ? 0 : pow(q, (double)(k + 1) * GAP_WIDTH);
+        expected[k] = gap_total * (from - to);
+    }
+    double gap_chi2 = chi_square(tests->gaps, expected, GAP_CLASSES);
+    failed += report_line("gap", "chi-square", gap_chi2, GAP_CLASSES - 1, chi_square_p(gap_chi2, GAP_CLASSES - 1));
+
+    //wheel distance between consecutive pockets
+    for (uint32_t i = 0; i < ARR_SIZE; i++) {
+        expected[i] = (double)(n - 1) / ARR_SIZE;
+    }
+    double wheel_chi2 = chi_square(wheel_steps, expected, ARR_SIZE);
+    failed += report_line("wheel adjacency", "chi-square", wheel_chi2, ARR_SIZE - 1,
+                          chi_square_p(wheel_chi2, ARR_SIZE - 1));
+
+    //set bits of the raw words
+    if (tests->words > 0) {
+        double bits = 32.0 * tests->words;
+        double monobit_z = ((double)tests->ones - (bits / 2)) / sqrt(bits / 4);
+        failed += report_line("monobit", "z", monobit_z, 0, normal_p(monobit_z));
+    }
+    printf("\n%u of %u tests failed at p < %g or p > %g\n", failed, (tests->words > 0) ? 6 : 5, RNG_TEST_ALPHA,
+           1 - RNG_TEST_ALPHA);
+    return failed;
+}
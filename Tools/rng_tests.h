@@ -0,0 +1,35 @@
+#ifndef TOOLS_RNG_TESTS_H_
+#define TOOLS_RNG_TESTS_H_
+#include "spots.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define GAP_CLASSES 32 //gap length classes, the last takes every longer gap
+#define GAP_WIDTH 8 //gap lengths per class
+#define RUN_SPLIT (ARR_SIZE / 2) //pockets under this are "low" for the runs test
+#define RNG_TEST_ALPHA 0.001 //a test fails below this p-value or above 1 - this
+
+//counts for every test, fed incrementally so any stream length fits in fixed memory
+//pocket frequencies, wheel steps and runs all follow from the pair counts and the first
+//pocket, so the per pocket work is one pair count, one gap count and one position.
+//the counts of a stream segment merge onto those of the segment before it
+typedef struct {
+    uint64_t count; //pockets seen
+    uint8_t first; //first pocket, POCKET_INVALID before it
+    uint8_t previous; //last pocket, POCKET_INVALID before the first
+    uint64_t pairs[ARR_SIZE][ARR_SIZE]; //overlapping pairs of consecutive pockets
+    uint64_t first_seen[ARR_SIZE]; //position of the first time each pocket came up, 1 based, 0 if never
+    uint64_t last_seen[ARR_SIZE]; //position of the last time each pocket came up, 1 based, 0 if never
+    uint64_t gaps[GAP_CLASSES]; //pockets between repeats of the same pocket, in classes
+    uint64_t words; //raw words seen, 0 when fed pockets
+    uint64_t ones; //set bits over the raw words
+    uint64_t rejected; //raw words rejected by the pocket mapping
+} PocketTests;
+
+void pocket_tests_init(PocketTests *);
+void pocket_tests_add_pockets(PocketTests *, const uint8_t *, size_t);
+void pocket_tests_add_words(PocketTests *, const uint32_t *, size_t);
+void pocket_tests_merge(PocketTests *, const PocketTests *);
+uint8_t pocket_tests_report(const PocketTests *);
+
+#endif
@@ -0,0 +1,428 @@
+//exact risk of ruin solver, runs on the build host
+//
+//plays a flat one-stake bet from a starting balance until the balance can no longer cover
+//the stake (ruin) or reaches the goal. bankroll states are counted in stakes, a spin moves
+//the state by payout - 1 with the probability of the pockets paying it in payout_matrix.
+//  - ruin and goal probabilities and the expected spins for every starting state come
+//    from one banded elimination of the absorbing chain, O(states * largest win)
+//  - the distribution of spins to absorption comes from stepping the state distribution
+//    spin by spin up to a horizon, in cache sized tiles that advance several spins each
+//  - -c plays the same sessions with the Monte Carlo engine and checks the answers
+//
+//build and run (from the repository root):
+//  gcc -O3 -pthread -ICore/Src -ITools Tools/ruin.c Tools/sim.c Core/Src/chips.c Core/Src/bets.c Core/Src/spots.c Core/Src/payouts_*.c -lm -o ruin
+//  ./ruin -b Red -u 5 -B 500000 -g 505000 -l 2e5
+//  ./ruin -b Straight -u 5 -c 1e5
+#include "bets.h"
+#include "chips.h"
+#include "sim.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <x86intrin.h>
+
+#define TILE_STATES 4096 //states written per tile, two tile buffers stay in L2
+#define TILE_STEPS 32 //most spins a tile advances before it is written back
+#define DEFAULT_HORIZON 1000000 //spins the distribution is stepped to at most
+#define DEFAULT_TOLERANCE 1e-12 //unabsorbed probability that ends the stepping
+
+//outcomes of one spin as bankroll moves in stakes
+typedef struct {
+    uint8_t count; //distinct moves
+    int32_t move[ARR_SIZE]; //payout - 1 of each move
+    double prob[ARR_SIZE]; //probability of each move
+    int32_t up; //largest gain
+    int32_t down; //largest loss
+} SpinOutcomes;
+
+//structure to hold the Monte Carlo check of one thread
+typedef struct {
+    uint64_t seed; //seed of the run
+    uint64_t first; //first session of the thread
+    uint8_t bet_id; //bet played on every spin
+    uint32_t start; //starting state
+    uint32_t target; //goal state
+    uint64_t sessions; //sessions to play
+    uint64_t goals; //sessions that reached the goal
+    double spins; //spins over all sessions
+    double spins_sq; //squared spins over all sessions
+} __attribute__((aligned(64))) RuinThread;
+
+//group the pockets of a bet by bankroll move
+static SpinOutcomes spin_outcomes(uint8_t bet_id) {
+    SpinOutcomes outcomes = {0};
+    for (uint8_t p = 0; p < ARR_SIZE; p++) {
+        int32_t move = (int32_t)payout_matrix[bet_id][p] - 1;
+        uint8_t i = 0;
+        while (i < outcomes.count && outcomes.move[i] != move) {
+            i++;
+        }
+        if (i == outcomes.count) {
+            outcomes.move[outcomes.count++] = move;
+        }
+        outcomes.prob[i] += 1.0 / ARR_SIZE;
+        outcomes.up = (move > outcomes.up) ? move : outcomes.up;
+        outcomes.down = (-move > outcomes.down) ? -move : outcomes.down;
+    }
+    return outcomes;
+}
+
+//goal probability and expected spins from every state 1..target-1, by banded elimination
+//row b of the chain is x[b] - sum q_m x[b + m] = (goal mass leaving b), the only entry below
+//the diagonal is the one stake loss, so each row is eliminated against the row before it
+//and keeps at most up entries right of the diagonal
+static int solve_exact(const SpinOutcomes *o, uint32_t target, double *goal, double *spins) {
+    size_t width = (size_t)o->up;
+    double *upper = calloc((size_t)target * width, sizeof(double));
+    double *row = calloc(width + 1, sizeof(double));
+    if (upper == NULL || row == NULL || o->down > 1) {
+        free(upper);
+        free(row);
+        return -1;
+    }
+    double loss = 0;
+    for (uint8_t i = 0; i < o->count; i++) {
+        loss += (o->move[i] == -1) ? o->prob[i] : 0;
+    }
+    for (uint32_t b = 1; b < target; b++) {
+        double goal_rhs = 0;
+        double spins_rhs = 1;
+        memset(row, 0, (width + 1) * sizeof(double));
+        row[0] = 1;
+        for (uint8_t i = 0; i < o->count; i++) {
+            int32_t m = o->move[i];
+            if (m < 0) {
+                continue;
+            } else if (b + (uint32_t)m >= target) {
+                goal_rhs += o->prob[i];
+            } else {
+                row[m] -= o->prob[i];
+            }
+        }
+        if (b > 1) {
+            //subtract -loss times the normalized row b - 1, its entries sit one column left
+            const double *prev = &upper[(size_t)(b - 1) * width];
+            for (size_t k = 1; k <= width; k++) {
+                row[k - 1] += loss * prev[k - 1];
+            }
+            goal_rhs += loss * goal[b - 1];
+            spins_rhs += loss * spins[b - 1];
+        }
+        double pivot = row[0];
+        double *out = &upper[(size_t)b * width];
+        for (size_t k = 1; k <= width; k++) {
+            out[k - 1] = row[k] / pivot;
+        }
+        goal[b] = goal_rhs / pivot;
+        spins[b] = spins_rhs / pivot;
+    }
+    //back substitution, states at or past the goal are absorbed and stay 0
+    for (uint32_t b = target - 1; b >= 1; b--) {
+        const double *u = &upper[(size_t)b * width];
+        double g = goal[b];
+        double s = spins[b];
+        for (size_t k = 1; k <= width && b + k < target; k++) {
+            g -= u[k - 1] * goal[b + k];
+            s -= u[k - 1] * spins[b + k];
+        }
+        goal[b] = g;
+        spins[b] = s;
+    }
+    free(upper);
+    free(row);
+    return 0;
+}
+
+//one spin of the state distribution over count states, dst[i] = sum q_m src[i - m]
+__attribute__((target_clones("avx512f", "avx2", "default")))
+static void step_states(double *restrict dst, const double *restrict src, size_t count, const SpinOutcomes *o) {
+    const double q0 = o->prob[0];
+    const int32_t m0 = o->move[0];
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = q0 * src[i - m0];
+    }
+    for (uint8_t j = 1; j < o->count; j++) {
+        const double q = o->prob[j];
+        const int32_t m = o->move[j];
+        for (size_t i = 0; i < count; i++) {
+            dst[i] += q * src[i - m];
+        }
+    }
+}
+
+//probability that leaves the states [lo, hi) through ruin or the goal on the next spin
+static void absorbed_mass(const SpinOutcomes *o, const double *v, int64_t lo, int64_t hi, uint32_t target,
+                          double *ruin, double *goal) {
+    for (uint8_t j = 0; j < o->count; j++) {
+        int32_t m = o->move[j];
+        //ruin below state 1 - m, goal from state target - m up
+        int64_t from = (m < 0) ? lo : ((target - m > lo) ? target - m : lo);
+        int64_t to = (m < 0) ? ((1 - m < hi) ? 1 - m : hi) : hi;
+        double sum = 0;
+        for (int64_t b = from; b < to; b++) {
+            sum += v[b];
+        }
+        if (m < 0) {
+            *ruin += o->prob[j] * sum;
+        } else if (m > 0) {
+            *goal += o->prob[j] * sum;
+        }
+    }
+}
+
+//step the distribution from start until the unabsorbed probability is below tolerance or
+//the horizon, ruin_at[t] and goal_at[t] get the probability absorbed on spin t
+//each tile copies its states plus the halo its spins reach into two local buffers,
+//advances them chunk spins in cache and writes back only the states it owns
+static uint32_t step_distribution(const SpinOutcomes *o, uint32_t start, uint32_t target, uint32_t horizon,
+                                  double tolerance, double *ruin_at, double *goal_at, double *remaining) {
+    int64_t up = o->up;
+    int64_t down = o->down;
+    uint32_t chunk = TILE_STATES / (4 * (uint32_t)(up + down));
+    chunk = (chunk < 1) ? 1 : ((chunk > TILE_STEPS) ? TILE_STEPS : chunk);
+    size_t span = TILE_STATES + ((size_t)chunk * (size_t)(up + down));
+    double *cur = calloc(target, sizeof(double));
+    double *next = calloc(target, sizeof(double));
+    double *a = malloc(span * sizeof(double));
+    double *b = malloc(span * sizeof(double));
+    if (cur == NULL || next == NULL || a == NULL || b == NULL) {
+        free(cur); free(next); free(a); free(b);
+        return 0;
+    }
+    cur[start] = 1;
+    *remaining = 1;
+    uint32_t t = 0;
+    while (t < horizon && *remaining >= tolerance) {
+        uint32_t steps = (horizon - t < chunk) ? horizon - t : chunk;
+        //states reachable by the end of the chunk
+        int64_t lo_state = (int64_t)start - ((int64_t)(t + steps) * down);
+        int64_t hi_state = (int64_t)start + ((int64_t)(t + steps) * up) + 1;
+        lo_state = (lo_state < 1) ? 1 : lo_state;
+        hi_state = (hi_state > target) ? target : hi_state;
+        for (int64_t lo = lo_state; lo < hi_state; lo += TILE_STATES) {
+            int64_t hi = (lo + TILE_STATES < hi_state) ? lo + TILE_STATES : hi_state;
+            //local index 0 is state base, states outside 1..target-1 hold 0
+            int64_t base = lo - ((int64_t)steps * up);
+            size_t size = (size_t)(hi - lo) + ((size_t)steps * (size_t)(up + down));
+            memset(a, 0, size * sizeof(double));
+            memset(b, 0, size * sizeof(double));
+            int64_t copy_lo = (base < 1) ? 1 : base;
+            int64_t copy_hi = (base + (int64_t)size < target) ? base + (int64_t)size : target;
+            if (copy_hi > copy_lo) {
+                memcpy(a + (copy_lo - base), cur + copy_lo, (size_t)(copy_hi - copy_lo) * sizeof(double));
+            }
+            double *src = a;
+            double *dst = b;
+            for (uint32_t s = 0; s < steps; s++) {
+                //absorption on spin t + s + 1, counted only on the owned states
+                absorbed_mass(o, src - base, lo, hi, target, &ruin_at[t + s + 1], &goal_at[t + s + 1]);
+                //valid states shrink by the halo of one spin each step
+                int64_t from = lo - ((int64_t)(steps - s - 1) * up);
+                int64_t to = hi + ((int64_t)(steps - s - 1) * down);
+                from = (from < 1) ? 1 : from;
+                to = (to > target) ? target : to;
+                if (to > from) {
+                    step_states(dst + (from - base), src + (from - base), (size_t)(to - from), o);
+                }
+                double *swap = src;
+                src = dst;
+                dst = swap;
+            }
+            memcpy(next + lo, src + (lo - base), (size_t)(hi - lo) * sizeof(double));
+        }
+        double *swap = cur;
+        cur = next;
+        next = swap;
+        t += steps;
+        double sum = 0;
+        for (int64_t s = lo_state; s < hi_state; s++) {
+            sum += cur[s];
+        }
+        *remaining = sum;
+    }
+    free(cur); free(next); free(a); free(b);
+    return t;
+}
+
+//play flat sessions until ruin or the goal, session n reads stream n of the seed
+static void *ruin_thread(void *arg) {
+    RuinThread *thread = arg;
+    const uint8_t *payouts = payout_matrix[thread->bet_id];
+    for (uint64_t i = 0; i < thread->sessions; i++) {
+        int64_t state = thread->start;
+        uint64_t spins = 0;
+        SimRng rng;
+        sim_rng_seed(&rng, thread->seed, thread->first + i);
+        while (state > 0 && state < thread->target) {
+            state += (int64_t)payouts[sim_spin(&rng)] - 1;
+            spins++;
+        }
+        thread->goals += (state >= thread->target);
+        thread->spins += (double)spins;
+        thread->spins_sq += (double)spins * (double)spins;
+    }
+    return NULL;
+}
+
+//first spin by which a fraction of the sessions are absorbed, 0 if not within the horizon
+static uint32_t spins_quantile(const double *ruin_at, const double *goal_at, uint32_t steps, double fraction) {
+    double seen = 0;
+    for (uint32_t t = 1; t <= steps; t++) {
+        seen += ruin_at[t] + goal_at[t];
+        if (seen >= fraction) {
+            return t;
+        }
+    }
+    return 0;
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-b bet type] [-u stake] [-B balance] [-g goal] [-l horizon]\n"
+                    "       [-e tolerance] [-c check sessions] [-t threads] [-s seed]\n", name);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    BetType bet_type = BET_RED;
+    uint32_t stake = RED_VAL;
+    uint32_t balance = calculate_total_balance(starting_chips);
+    uint32_t goal_balance = 0;
+    uint32_t horizon = DEFAULT_HORIZON;
+    double tolerance = DEFAULT_TOLERANCE;
+    uint64_t check = 0;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t threads = (cores > 0) ? (uint32_t)cores : 1;
+    uint64_t seed = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "b:u:B:g:l:e:c:t:s:")) != -1) {
+        switch (opt) {
+            case 'b': bet_type = parse_bet_type(optarg); break;
+            case 'u': stake = (uint32_t)atoi(optarg); break;
+            case 'B': balance = (uint32_t)atoi(optarg); break;
+            case 'g': goal_balance = (uint32_t)atoi(optarg); break;
+            case 'l': horizon = (uint32_t)sim_parse_count(optarg); break;
+            case 'e': tolerance = strtod(optarg, NULL); break;
+            case 'c': check = sim_parse_count(optarg); break;
+            case 't': threads = (uint32_t)atoi(optarg); break;
+            case 's': seed = strtoull(optarg, NULL, 0); break;
+            default: usage(argv[0]);
+        }
+    }
+    if (goal_balance == 0) {
+        goal_balance = 2 * balance; //play to double up
+    }
+    if (bet_type == BET_TYPE_NONE || stake == 0 || threads == 0 || balance < stake || goal_balance <= balance) {
+        usage(argv[0]);
+    }
+    //states count whole stakes, change smaller than a stake cannot be played
+    uint32_t start = balance / stake;
+    uint32_t target = (goal_balance + stake - 1) / stake;
+    uint8_t bet_id = bet_type_first_id[bet_type];
+    SpinOutcomes outcomes = spin_outcomes(bet_id);
+
+    double *goal = calloc(target, sizeof(double));
+    double *spins = calloc(target, sizeof(double));
+    double *ruin_at = calloc((size_t)horizon + 1, sizeof(double));
+    double *goal_at = calloc((size_t)horizon + 1, sizeof(double));
+    if (goal == NULL || spins == NULL || ruin_at == NULL || goal_at == NULL) {
+        fprintf(stderr, "ruin: out of memory\n");
+        return 1;
+    }
+    //probabilities under 1e-308 do not matter, flush them instead of paying for subnormals
+    _mm_setcsr(_mm_getcsr() | 0x8040);
+    double begin = sim_now();
+    if (solve_exact(&outcomes, target, goal, spins) != 0) {
+        fprintf(stderr, "ruin: out of memory\n");
+        return 1;
+    }
+    double solve_time = sim_now() - begin;
+    begin = sim_now();
+    double remaining = 1;
+    uint32_t steps = step_distribution(&outcomes, start, target, horizon, tolerance, ruin_at, goal_at, &remaining);
+    double step_time = sim_now() - begin;
+
+    printf("%s bet of $%u on the %s wheel from $%u to $%u: %u to %u stakes\n\n", bet_type_names[bet_type], stake, WHEEL_NAME, balance,
+           goal_balance, start, target);
+    printf("exact (%u states in %.3f s)\n", target - 1, solve_time);
+    printf("  P(ruin)          %.10g\n", 1.0 - goal[start]);
+    printf("  P(goal)          %.10g\n", goal[start]);
+    printf("  expected spins   %.2f\n", spins[start]);
+    double ruin_sum = 0;
+    double goal_sum = 0;
+    double mean = 0;
+    for (uint32_t s = 1; s <= steps; s++) {
+        ruin_sum += ruin_at[s];
+        goal_sum += goal_at[s];
+        mean += (double)s * (ruin_at[s] + goal_at[s]);
+    }
+    printf("spins to absorption (%u spins in %.3f s)\n", steps, step_time);
+    printf("  P(ruin) by then  %.10g\n", ruin_sum);
+    printf("  P(goal) by then  %.10g\n", goal_sum);
+    printf("  unabsorbed       %.3g\n", remaining);
+    if (ruin_sum + goal_sum > 0) {
+        printf("  mean (absorbed)  %.2f\n", mean / (ruin_sum + goal_sum));
+    }
+    static const double fractions[] = {0.01, 0.10, 0.50, 0.90, 0.99};
+    for (uint8_t f = 0; f < sizeof(fractions) / sizeof(fractions[0]); f++) {
+        uint32_t q = spins_quantile(ruin_at, goal_at, steps, fractions[f]);
+        if (q == 0) {
+            printf("  P%-2.0f             past the horizon\n", 100 * fractions[f]);
+        } else {
+            printf("  P%-2.0f             %u\n", 100 * fractions[f], q);
+        }
+    }
+
+    if (check > 0) {
+        RuinThread *work = aligned_alloc(64, threads * sizeof(RuinThread));
+        if (work == NULL) {
+            fprintf(stderr, "ruin: out of memory\n");
+            return 1;
+        }
+        for (uint32_t i = 0; i < threads; i++) {
+            memset(&work[i], 0, sizeof(RuinThread));
+            work[i].seed = seed;
+            work[i].first = ((check / threads) * i) + ((i < check % threads) ? i : check % threads);
+            work[i].bet_id = bet_id;
+            work[i].start = start;
+            work[i].target = target;
+            work[i].sessions = (check / threads) + ((i < check % threads) ? 1 : 0);
+        }
+        begin = sim_now();
+        if (sim_run_threads(threads, ruin_thread, work, sizeof(RuinThread)) != 0) {
+            fprintf(stderr, "ruin: cannot start threads\n");
+            return 1;
+        }
+        double check_time = sim_now() - begin;
+        uint64_t goals = 0;
+        double spins_total = 0;
+        double spins_sq = 0;
+        for (uint32_t i = 0; i < threads; i++) {
+            goals += work[i].goals;
+            spins_total += work[i].spins;
+            spins_sq += work[i].spins_sq;
+        }
+        //z scores against the exact answers, |z| < 2.58 is inside the 99% bounds
+        double p = goal[start];
+        double goal_rate = (double)goals / check;
+        double goal_z = (goal_rate - p) / sqrt(p * (1 - p) / check);
+        double spins_mean = spins_total / check;
+        double spins_var = (spins_sq / check) - (spins_mean * spins_mean);
+        double spins_z = (spins_mean - spins[start]) / sqrt(spins_var / check);
+        printf("Monte Carlo check (%llu sessions on %u thread(s) in %.2f s)\n", (unsigned long long)check,
+               threads, check_time);
+        printf("  P(goal)          %.6f  z %+.2f %s\n", goal_rate, goal_z, (fabs(goal_z) < 2.58) ? "ok" : "OUTSIDE 99%");
+        printf("  mean spins       %.2f  z %+.2f %s\n", spins_mean, spins_z, (fabs(spins_z) < 2.58) ? "ok" : "OUTSIDE 99%");
+        free(work);
+        if (fabs(goal_z) >= 2.58 || fabs(spins_z) >= 2.58) {
+            return 1;
+        }
+    }
+    free(goal);
+    free(spins);
+    free(ruin_at);
+    free(goal_at);
+    return 0;
+}
@@ -0,0 +1,363 @@
+//terminal bytes per game round, runs on the build host
+//
+//builds usart.c against the register stand-in in Tools/hal with a DMA that finishes every
+//transfer at once, then plays rounds the way main.c draws them: one to three bets each
+//highlighting the table and updating the chips, a spin drawing every wheel frame the pacing of
+//main.c shows from launch to rest, and the result clearing the highlights and paying out. reports the bytes each kind of
+//draw sends and the time they take on the wire, and what the first full paint of the wheel,
+//table and chips costs. the rounds also print the prompts main.c asks and echo typical
+//answers, and the transmit counters of usart.c are exported per game state and screen region,
+//so repaints can be weighed against prompts. built against an older usart.c (without Core/Src/screen.c) it measures
+//that renderer on the same rounds.
+//
+//before the rounds it boots the way main() does with the DMA sending a byte every bit time of
+//the baud rate and the CPU spending BOOT_POINT_US at every point the firmware lets interrupts
+//in, and reports when main() is ready for input, when the first prompt is on the terminal and
+//when the whole screen is.
+//
+//build and run (from the repository root):
+//  gcc -O2 -ITools/hal -ICore/Src Tools/screen_bench.c Core/Src/usart.c Core/Src/screen.c Core/Src/start_screen_*.c Core/Src/format.c Core/Src/physics.c Core/Src/pacing.c Core/Src/spots.c Core/Src/chips.c Core/Src/payouts_*.c -o screen_bench
+//  ./screen_bench -n 1000 -s 1
+#include "usart.h"
+#include "payouts.h"
+#include "pacing.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BAUD_RATE 115200 //as usart.c sets it up
+#define BITS_PER_BYTE 10 //start, 8 data and stop bits
+#define BYTE_US (1e6 * BITS_PER_BYTE / BAUD_RATE) //time one byte takes on the wire
+#define BOOT_POINT_US 0.25 //CPU time between two interrupt points, a pass of a wait loop
+#define SPIN_DURATION_MS 6000 //as main.c paces a spin
+#define SPIN_EASE (PACING_EASE_FULL / 2)
+
+//kinds of draw, a row of the report each
+typedef enum {
+    DRAW_START, //start screen outline, once at boot
+    DRAW_WHEEL_FULL, //first wheel, table and chips onto the blank outline
+    DRAW_TABLE_FULL,
+    DRAW_CHIPS_FULL,
+    DRAW_TABLE, //table highlights of a bet or the result
+    DRAW_CHIPS, //chip counts, bet and balance
+    DRAW_WHEEL, //wheel frames of a spin
+    NUM_DRAWS
+} DrawKind;
+
+#define FIRST_ROUND_DRAW DRAW_TABLE //draws before it happen once at boot
+
+//game states a round goes through, numbered as GameState in main.c
+typedef enum {
+    ST_INIT,
+    ST_TRADE,
+    ST_BET_TYPE,
+    ST_TABLE_UPDATE,
+    ST_BET_MONEY,
+    ST_SPIN,
+    ST_RESULT,
+    ST_END
+} BenchState;
+
+static const char *state_names[USART_TX_STATES] = {"INIT", "TRADE", "BET_TYPE", "TABLE_UPDATE", "BET_MONEY",
+                                                   "SPIN", "RESULT", "END"};
+static const char *region_names[NUM_REGIONS] = {"start", "wheel", "table", "chips", "balance", "bet", "prompt"};
+
+static const char *draw_names[NUM_DRAWS] = {"start screen", "wheel, full", "table, full", "chips, full",
+                                            "table", "chips", "wheel frames"};
+
+void DMA1_Channel7_IRQHandler(void);
+
+static GPIO_TypeDef gpioa;
+static USART_TypeDef usart2;
+static RCC_TypeDef rcc;
+static NVIC_Type nvic;
+static DMA_TypeDef dma1;
+static DMA_Channel_TypeDef dma1_channel7;
+static DMA_Request_TypeDef dma1_cselr;
+GPIO_TypeDef *GPIOA = &gpioa;
+USART_TypeDef *USART2 = &usart2;
+RCC_TypeDef *RCC = &rcc;
+NVIC_Type *NVIC = &nvic;
+DMA_TypeDef *DMA1 = &dma1;
+DMA_Channel_TypeDef *DMA1_Channel7 = &dma1_channel7;
+DMA_Request_TypeDef *DMA1_CSELR = &dma1_cselr;
+uint32_t host_primask = 1; //interrupts stay off, the writers drain the DMA themselves
+
+//the boot runs on a clock, the DMA sends a byte at a time from when it was started
+typedef struct {
+    bool timed; //at the baud rate rather than whole transfers at once
+    double now; //CPU time in microseconds
+    double next_byte; //time the byte on the wire finishes
+    uint32_t total; //bytes of the transfer in flight, 0 when idle
+    uint32_t sent; //bytes on the wire
+    uint32_t mark; //bytes on the wire the moment of interest
+    double mark_time; //time the wire got to mark, 0 until it has
+    bool in_interrupt;
+} BootClock;
+
+static BootClock boot;
+
+static uint64_t rng_state;
+static uint64_t draw_bytes[NUM_DRAWS]; //bytes sent by each kind of draw
+static uint64_t draw_calls[NUM_DRAWS]; //draws of each kind
+static uint32_t sent_before; //bytes queued before the draw being measured
+static uint64_t spin_frames; //wheel frames of every spin
+static uint64_t physics_steps; //physics steps from launch to rest of every spin
+
+//the DMA sends a whole transfer between any two instructions, or during the boot the bytes
+//whose time has come, and the interrupt runs if it is on
+void host_interrupt_point(void) {
+    dma1.ISR &= ~((dma1.IFCR & DMA_IFCR_CGIF7) ? (DMA_ISR_GIF7 | DMA_ISR_TCIF7 | DMA_ISR_HTIF7 | DMA_ISR_TEIF7) : dma1.IFCR);
+    dma1.IFCR = 0;
+    if (!(dma1_channel7.CCR & DMA_CCR_EN) || dma1_channel7.CNDTR == 0) {
+        boot.total = 0;
+    } else if (!boot.timed) {
+        dma1_channel7.CNDTR = 0;
+        dma1.ISR |= DMA_ISR_GIF7 | DMA_ISR_TCIF7;
+    } else {
+        if (boot.total == 0) {
+            boot.total = dma1_channel7.CNDTR;
+            boot.next_byte = boot.now + BYTE_US;
+        }
+        while (dma1_channel7.CNDTR > 0 && boot.next_byte <= boot.now) {
+            dma1_channel7.CNDTR--;
+            boot.sent++;
+            boot.mark_time = (boot.sent == boot.mark) ? boot.next_byte : boot.mark_time;
+            boot.next_byte += BYTE_US;
+            dma1.ISR |= (dma1_channel7.CNDTR == boot.total / 2) ? DMA_ISR_GIF7 | DMA_ISR_HTIF7 : 0;
+        }
+        if (dma1_channel7.CNDTR == 0) {
+            //done, the interrupt may start the next transfer before the next point
+            dma1.ISR |= DMA_ISR_GIF7 | DMA_ISR_TCIF7;
+            boot.total = 0;
+        }
+    }
+    boot.now += boot.timed ? BOOT_POINT_US : 0;
+    if (host_primask == 0 && !boot.in_interrupt && (dma1.ISR & (DMA_ISR_TCIF7 | DMA_ISR_HTIF7))) {
+        boot.in_interrupt = true;
+        DMA1_Channel7_IRQHandler();
+        boot.in_interrupt = false;
+    }
+}
+
+//boot as main() does and print the first prompt, then wait for the screen to finish
+static void measure_boot(Chips *chips) {
+    boot.timed = true;
+    USART_start_screen();
+    USART_print_wheel(wheel_arr, 0);
+    USART_print_table(0);
+    USART_print_chips(chips, 0);
+    double ready = boot.now;
+    host_primask = 0;
+    USART_ESC_Code(TOP_LEFT);
+    USART_ESC_Code(DOWN_35);
+    USART_ESC_Code(CLEAR_LINE);
+    USART_print_string("Welcome to Roulette! Press Enter to begin.");
+    boot.mark = USART_tx_stats().queued;
+    USART_tx_flush();
+    double done = boot.now;
+    host_primask = 1;
+    boot.timed = false;
+    printf("boot at %u baud: ready for input %.1f ms, first prompt shown %.1f ms, screen done %.1f ms (%u bytes)\n\n",
+           BAUD_RATE, ready / 1000, boot.mark_time / 1000, done / 1000, boot.sent);
+}
+
+//xorshift64, only picks bets, chips and launches
+static uint32_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+static void begin_draw(void) {
+    sent_before = USART_tx_stats().queued;
+}
+
+static void end_draw(DrawKind kind) {
+    draw_bytes[kind] += USART_tx_stats().queued - sent_before;
+    draw_calls[kind]++;
+}
+
+//stake a few chips of one value the player holds, returns the amount
+static uint32_t stake_chips(Chips *chips) {
+    static const uint32_t values[POSSIBLE_CHIPS] = {YELLOW_VAL, PURPLE_VAL, BLACK_VAL, ORANGE_VAL,
+                                                    GREEN_VAL, BLUE_VAL, RED_VAL, WHITE_VAL};
+    for (uint8_t tries = 0; tries < 4 * POSSIBLE_CHIPS; tries++) {
+        uint32_t value = values[next_random() % POSSIBLE_CHIPS];
+        uint32_t *count = get_chip_pointer(value, chips);
+        if (*count > 0) {
+            uint32_t quantity = 1 + (next_random() % ((*count < 3) ? *count : 3));
+            *count -= quantity;
+            return value * quantity;
+        }
+    }
+    return 0;
+}
+
+//ask on the prompt line as main.c does and echo the answer as the USART2 interrupt does
+static void prompt(const char *question, const char *answer) {
+    USART_ESC_Code(CLEAR_LINE);
+    USART_ESC_Code(FULLY_LEFT);
+    USART_print_string(question);
+    USART_print_string(answer);
+}
+
+//one round as main.c draws it
+static void play_round(Chips *chips) {
+    PocketMask slip_pockets = 0;
+    uint32_t staked = 0;
+    uint8_t bets = 1 + (next_random() % 3);
+    USART_tx_state(ST_TRADE);
+    prompt("Trade in chips? (yes/no) --> ", "no");
+    for (uint8_t b = 0; b < bets; b++) {
+        uint8_t id = next_random() % NUM_BET_IDS;
+        USART_tx_state(ST_BET_TYPE);
+        prompt("Choose your bet type (from above) --> ", "Split");
+        prompt("Enter Split number (refer to user manual or table) --> ", "17");
+        USART_tx_state(ST_TABLE_UPDATE);
+        begin_draw();
+        USART_print_table(bet_pockets[id] | slip_pockets);
+        end_draw(DRAW_TABLE);
+        slip_pockets |= bet_pockets[id];
+        USART_tx_state(ST_BET_MONEY);
+        for (uint8_t lots = 1 + (next_random() % 2); lots > 0; lots--) {
+            USART_ESC_Code(TOP_LEFT);
+            USART_ESC_Code(DOWN_35);
+            prompt("Enter chip value to bet or 'done' --> ", "25");
+            prompt("Enter quantity of chips --> ", "2");
+            staked += stake_chips(chips);
+            begin_draw();
+            USART_print_chips(chips, staked);
+            end_draw(DRAW_CHIPS);
+        }
+        USART_ESC_Code(TOP_LEFT);
+        USART_ESC_Code(DOWN_35);
+        prompt("Enter chip value to bet or 'done' --> ", "done");
+        prompt("Place another bet? (yes/no) --> ", (b + 1 < bets) ? "yes" : "no");
+    }
+    USART_tx_state(ST_SPIN);
+    prompt("Press Enter to spin the wheel...", "");
+    prompt("Spinning...", "");
+
+    uint32_t words[PHYSICS_WORDS];
+    for (uint8_t i = 0; i < PHYSICS_WORDS; i++) {
+        words[i] = next_random();
+    }
+    WheelSpin spin;
+    physics_launch(&spin, &wheel_physics, words);
+    physics_land_on(&spin, next_random() % ARR_SIZE);
+    SpinPacing pacing;
+    pacing_init(&pacing, spin.rest_step, SPIN_DURATION_MS, SPIN_EASE);
+    begin_draw();
+    for (uint32_t frame = 1; frame < pacing.frames; frame++) {
+        USART_print_wheel(wheel_arr, physics_index_at(&spin, pacing_step(&pacing, frame)));
+    }
+    end_draw(DRAW_WHEEL);
+    spin_frames += pacing.frames - 1;
+    physics_steps += spin.rest_step;
+
+    USART_tx_state(ST_RESULT);
+    begin_draw();
+    USART_print_table(0);
+    end_draw(DRAW_TABLE);
+    if (next_random() % 2 == 0) {
+        distribute_chips(2 * staked, chips);
+    }
+    if (calculate_total_balance(*chips) == 0) {
+        *chips = starting_chips;
+    }
+    begin_draw();
+    USART_print_chips(chips, 0);
+    end_draw(DRAW_CHIPS);
+    USART_ESC_Code(TOP_LEFT);
+    USART_ESC_Code(DOWN_35);
+    prompt("Congratulations! ", "You won $50! ");
+    USART_tx_state(ST_END);
+    prompt("Press Enter to play again!", "");
+}
+
+//the transmit counters of usart.c, bytes per round by game state and region (the boot is in
+//INIT) and the share of all bytes each region took
+static void print_regions(uint32_t rounds) {
+    uint64_t totals[NUM_REGIONS + 1] = {0};
+    printf("\nbytes per round by game state and screen region\n%-14s", "state");
+    for (uint8_t r = 0; r < NUM_REGIONS; r++) {
+        printf(" %9s", region_names[r]);
+    }
+    printf(" %9s\n", "total");
+    for (uint8_t state = 0; state < USART_TX_STATES; state++) {
+        uint64_t total = 0;
+        printf("%-14s", state_names[state]);
+        for (uint8_t r = 0; r < NUM_REGIONS; r++) {
+            uint32_t bytes = USART_tx_region_bytes(state, r);
+            printf(" %9.1f", (double)bytes / rounds);
+            total += bytes;
+            totals[r] += bytes;
+        }
+        printf(" %9.1f\n", (double)total / rounds);
+        totals[NUM_REGIONS] += total;
+    }
+    printf("%-14s", "share");
+    for (uint8_t r = 0; r <= NUM_REGIONS; r++) {
+        printf(" %8.1f%%", 100.0 * totals[r] / totals[NUM_REGIONS]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    uint32_t rounds = 1000;
+    rng_state = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            rounds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            rng_state = strtoull(argv[++i], NULL, 0) | 1;
+        } else {
+            rounds = 0;
+            break;
+        }
+    }
+    if (rounds == 0) {
+        fprintf(stderr, "usage: %s [-n rounds] [-s seed]\n", argv[0]);
+        return 2;
+    }
+    USART_init();
+    Chips chips = starting_chips;
+    measure_boot(&chips);
+    begin_draw();
+    USART_start_screen();
+    USART_tx_flush(); //painted out whole, so the draws after it are measured on their own
+    end_draw(DRAW_START);
+    begin_draw();
+    USART_print_wheel(wheel_arr, 0);
+    end_draw(DRAW_WHEEL_FULL);
+    begin_draw();
+    USART_print_table(0);
+    end_draw(DRAW_TABLE_FULL);
+    begin_draw();
+    USART_print_chips(&chips, 0);
+    end_draw(DRAW_CHIPS_FULL);
+    for (uint32_t r = 0; r < rounds; r++) {
+        play_round(&chips);
+    }
+    USART_tx_flush();
+
+    double byte_ms = BYTE_US / 1000;
+    printf("%u rounds of the %s wheel at %u baud\n\n", rounds, WHEEL_NAME, BAUD_RATE);
+    printf("%-14s %10s %12s %14s %12s\n", "draw", "draws", "bytes/draw", "bytes/round", "ms/round");
+    uint64_t round_bytes = 0;
+    for (uint8_t kind = 0; kind < NUM_DRAWS; kind++) {
+        double per_round = (kind < FIRST_ROUND_DRAW) ? 0 : (double)draw_bytes[kind] / rounds;
+        round_bytes += (kind < FIRST_ROUND_DRAW) ? 0 : draw_bytes[kind];
+        printf("%-14s %10llu %12.1f %14.1f %12.1f\n", draw_names[kind], (unsigned long long)draw_calls[kind],
+               (double)draw_bytes[kind] / draw_calls[kind], per_round, per_round * byte_ms);
+    }
+    printf("%-14s %10s %12s %14.1f %12.1f\n", "round", "", "", (double)round_bytes / rounds,
+           (double)round_bytes / rounds * byte_ms);
+    printf("\nspins: %.1f wheel frames over %.2f s, the physics takes %.2f s\n", (double)spin_frames / rounds,
+           (double)spin_frames / rounds / PHYSICS_FRAME_HZ, (double)physics_steps / rounds / PHYSICS_STEP_HZ);
+    print_regions(rounds);
+    return 0;
+}
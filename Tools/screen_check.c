@@ -0,0 +1,739 @@
+//terminal regression check of the game screens, runs on the build host
+//
+//builds usart.c against the register stand-in in Tools/hal with a DMA that sends a byte every
+//bit time of the baud rate into the terminal emulator of vt.c, then plays a fixed session the
+//way main.c draws it: the boot, a chip trade, a straight bet that wins and a split bet, the
+//spin, its result and the next round up to a mistyped bet type, the player typing at KEY_US a
+//key. every state the session goes through is a step, and at the end of each the screen the
+//terminal shows is compared with its golden copy in Tools/screens/<wheel>.txt together with two
+//budgets recorded with it: the bytes the step sent, and its latency, the longest the player
+//waited from pressing Enter (or from the end of a message's delay) until the next prompt was
+//all on the terminal. a screen that differs, a budget exceeded or an escape code the emulator
+//does not know fails the run, a step under its budgets only says so. a row of the start screen
+//still blank when the game leaves INIT fails it too, even with -u. last the transmit report is
+//typed at the final prompt on a terminal SCREEN_COLS wide, failing the run if a line of it wraps
+//or it changes the counters it reports.
+//
+//after a change to what the game draws, look over the new screens and record them with -u,
+//which sets the budgets to what the steps take now.
+//
+//build and run (from the repository root):
+//  for zeros in 1 2 3; do
+//    gcc -O2 -DWHEEL_ZEROS=$zeros -ITools/hal -ICore/Src Tools/screen_check.c Tools/vt.c Core/Src/usart.c Core/Src/screen.c Core/Src/start_screen_*.c Core/Src/format.c Core/Src/spots.c Core/Src/chips.c Core/Src/bets.c Core/Src/payouts_*.c Core/Src/physics.c Core/Src/pacing.c -o screen_check && ./screen_check
+//  done
+//  ./screen_check -u (record), -f file (golden file other than Tools/screens/<wheel>.txt)
+#include "usart.h"
+#include "bets.h"
+#include "pacing.h"
+#include "vt.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BAUD_RATE 115200 //as usart.c sets it up
+#define BITS_PER_BYTE 10 //start, 8 data and stop bits
+#define BYTE_US (1e6 * BITS_PER_BYTE / BAUD_RATE) //time one byte takes on the wire
+#define POINT_US 0.25 //CPU time between two interrupt points, a pass of a wait loop
+#define KEY_US 150000.0 //time between two keys the player types
+#define DEL_US 2000000.0 //wait_for_delay(DEL) of main.c
+#define SPIN_DURATION_MS 6000 //as main.c paces a spin
+#define SPIN_EASE (PACING_EASE_FULL / 2)
+#define SPIN_TX_BUDGET 300
+#define WIN_INDEX 7 //wheel index the spin lands on, the straight bet is on its pocket
+#define MAX_STEPS 16
+#define INPUT_SIZE 64 //typed line, as usart_input_buffer of main.c
+#define SCREEN_TEXT_SIZE (64 + (2 * SCREEN_ROWS * (SCREEN_COLS + 8))) //a step's screen as text
+#define GOLDEN_SIZE (MAX_STEPS * (SCREEN_TEXT_SIZE + 64) + 256)
+
+//attribute of a cell in the golden text, '.' for none
+static const char attr_codes[] = ".123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz+/";
+
+#if WHEEL_ZEROS == 1
+#define VARIANT "single" //golden file name
+#elif WHEEL_ZEROS == 2
+#define VARIANT "double"
+#else
+#define VARIANT "triple"
+#endif
+
+//game states, numbered as GameState in main.c
+typedef enum {
+    ST_INIT,
+    ST_TRADE,
+    ST_BET_TYPE,
+    ST_TABLE_UPDATE,
+    ST_BET_MONEY,
+    ST_SPIN,
+    ST_RESULT,
+    ST_END
+} CheckState;
+
+static const char *state_names[USART_TX_STATES] = {"INIT", "TRADE", "BET_TYPE", "TABLE_UPDATE", "BET_MONEY",
+                                                   "SPIN", "RESULT", "END"};
+
+//one state the session went through
+typedef struct {
+    uint8_t state;
+    uint32_t bytes; //bytes written from the start of the step to the start of the next
+    uint32_t latency_us; //longest wait for a prompt
+    uint32_t end; //bytes queued when the step was over
+    bool over;
+    char screen[SCREEN_TEXT_SIZE]; //terminal at the end of the step, as the golden file has it
+} Step;
+
+//a step as the golden file recorded it
+typedef struct {
+    char state[16];
+    uint32_t bytes;
+    uint32_t latency_us;
+    const char *screen; //into the golden text, up to the next step
+    size_t screen_length;
+} GoldenStep;
+
+void DMA1_Channel7_IRQHandler(void);
+
+static GPIO_TypeDef gpioa;
+static USART_TypeDef usart2;
+static RCC_TypeDef rcc;
+static NVIC_Type nvic;
+static DMA_TypeDef dma1;
+static DMA_Channel_TypeDef dma1_channel7;
+static DMA_Request_TypeDef dma1_cselr;
+GPIO_TypeDef *GPIOA = &gpioa;
+USART_TypeDef *USART2 = &usart2;
+RCC_TypeDef *RCC = &rcc;
+NVIC_Type *NVIC = &nvic;
+DMA_TypeDef *DMA1 = &dma1;
+DMA_Channel_TypeDef *DMA1_Channel7 = &dma1_channel7;
+DMA_Request_TypeDef *DMA1_CSELR = &dma1_cselr;
+uint32_t host_primask = 1; //interrupts stay off until the boot turns them on
+
+//the wire runs on a clock, the DMA sends a byte at a time from when it was started
+typedef struct {
+    double now; //CPU time in microseconds
+    double next_byte; //time the byte on the wire finishes
+    uint32_t total; //bytes of the transfer in flight, 0 when idle
+    uint32_t sent; //bytes on the wire, every one fed to the terminal
+    bool in_interrupt;
+} WireClock;
+
+static WireClock wire;
+static VtTerminal vt;
+static Step steps[MAX_STEPS];
+static uint8_t step_count = 0;
+static uint8_t shown_count = 0; //steps whose screen has been taken
+static uint32_t step_start; //bytes queued when the step began
+static double answered; //time of the player's last Enter, or of the end of a message's delay
+static char input[INPUT_SIZE]; //last line the player typed
+static Chips player_chips;
+static BetSlip bet_slip;
+static uint8_t bet_id;
+static uint8_t blank_start_rows = 0; //rows of the start screen still blank on the terminal as INIT ended
+//wheel frames of the spin as main.c counts them, and the widest timer cycles the report can show
+static UsartSpinStats spin_stats = {{1, UINT32_MAX, UINT32_MAX, UINT32_MAX}, 0, 0, 0};
+
+static void screen_text(char *);
+
+//rows with anything on them in the packed start screen that the terminal shows blank
+static uint8_t count_blank_start_rows(void) {
+    static Screen start;
+    screen_load(&start, start_screen_packed);
+    uint8_t blank = 0;
+    for (uint8_t row = 0; row < SCREEN_ROWS; row++) {
+        bool drawn = false;
+        bool shown = false;
+        for (uint8_t col = 0; col < SCREEN_COLS; col++) {
+            drawn = drawn || start.cells[row][col].ch != ' ';
+            shown = shown || vt.cells[row][col].ch != ' ';
+        }
+        blank += drawn && !shown;
+    }
+    return blank;
+}
+
+//take the screen of every step that is over once its last byte is on the terminal, whatever has
+//been queued behind it since. the game leaves INIT with the whole start screen up
+static void take_screens(void) {
+    while (shown_count < step_count && steps[shown_count].over && wire.sent >= steps[shown_count].end) {
+        screen_text(steps[shown_count].screen);
+        if (steps[shown_count].state == ST_INIT) {
+            blank_start_rows = count_blank_start_rows();
+        }
+        shown_count++;
+    }
+}
+
+//the DMA sends the bytes whose time has come into the terminal, and the interrupt runs if it is on
+void host_interrupt_point(void) {
+    uint32_t clear = dma1.IFCR;
+    dma1.IFCR = 0;
+    dma1.ISR &= ~((clear & DMA_IFCR_CGIF7) ? (DMA_ISR_GIF7 | DMA_ISR_TCIF7 | DMA_ISR_HTIF7 | DMA_ISR_TEIF7) : clear);
+    if (!(dma1_channel7.CCR & DMA_CCR_EN) || dma1_channel7.CNDTR == 0) {
+        wire.total = 0;
+    } else {
+        if (wire.total == 0) {
+            wire.total = dma1_channel7.CNDTR;
+            wire.next_byte = wire.now + BYTE_US;
+        }
+        while (dma1_channel7.CNDTR > 0 && wire.next_byte <= wire.now) {
+            vt_feed(&vt, (const char *)dma1_channel7.CMAR + (wire.total - dma1_channel7.CNDTR), 1);
+            dma1_channel7.CNDTR--;
+            wire.sent++;
+            wire.next_byte += BYTE_US;
+            take_screens();
+            dma1.ISR |= (dma1_channel7.CNDTR == wire.total / 2) ? DMA_ISR_GIF7 | DMA_ISR_HTIF7 : 0;
+        }
+        if (dma1_channel7.CNDTR == 0) {
+            //done, the interrupt may start the next transfer before the next point
+            dma1.ISR |= DMA_ISR_GIF7 | DMA_ISR_TCIF7;
+            wire.total = 0;
+        }
+    }
+    wire.now += POINT_US;
+    if (host_primask == 0 && !wire.in_interrupt && (dma1.ISR & (DMA_ISR_TCIF7 | DMA_ISR_HTIF7))) {
+        wire.in_interrupt = true;
+        DMA1_Channel7_IRQHandler();
+        wire.in_interrupt = false;
+    }
+}
+
+//one pass of a wait loop of main.c, painting a row of the start screen if it would, then time
+//passes to the next byte on the wire or to limit, whichever comes first
+static void tick(double limit, bool paint) {
+    if (paint) {
+        USART_paint_screen();
+    }
+    bool busy = (dma1_channel7.CCR & DMA_CCR_EN) && dma1_channel7.CNDTR > 0;
+    double next = (busy && wire.next_byte < limit) ? wire.next_byte : limit;
+    wire.now = (next > wire.now) ? next : wire.now;
+    host_interrupt_point();
+}
+
+static void run_until(double time, bool paint) {
+    while (wire.now < time) {
+        tick(time, paint);
+    }
+}
+
+//a message shown for wait_for_delay(), which paints the start screen as waiting for input does
+static void pause(double us) {
+    run_until(wire.now + us, true);
+    answered = wire.now;
+}
+
+//count the bytes of the step up to here
+static void close_step(void) {
+    if (step_count > 0) {
+        steps[step_count - 1].bytes = USART_tx_stats().queued - step_start;
+    }
+}
+
+//the next step, its bytes counted from here
+static void begin_step(uint8_t state) {
+    close_step();
+    USART_tx_state(state);
+    steps[step_count].state = state;
+    steps[step_count].latency_us = 0;
+    steps[step_count].over = false;
+    step_start = USART_tx_stats().queued;
+    step_count++;
+}
+
+//the terminal as the golden file keeps it: the cursor, then the rows of the game between bars,
+//then the attributes of the rows that have any. a space takes no color, as screen.c has it
+static void screen_text(char *text) {
+    int length = sprintf(text, "cursor %u,%u%s%s\n", vt.cursor.row + 1, vt.cursor.col + 1,
+                         vt.cursor_visible ? "" : " hidden", vt.alternate ? " alternate screen" : "");
+    uint32_t outside = 0;
+    for (uint8_t row = 0; row < VT_ROWS; row++) {
+        for (uint8_t col = 0; col < VT_COLS; col++) {
+            outside += (row >= SCREEN_ROWS || col >= SCREEN_COLS) && vt.cells[row][col].ch != ' ';
+        }
+    }
+    if (outside > 0) {
+        length += sprintf(text + length, "%u cells drawn outside the game screen\n", outside);
+    }
+    for (uint8_t row = 0; row < SCREEN_ROWS; row++) {
+        text[length++] = '|';
+        for (uint8_t col = 0; col < SCREEN_COLS; col++) {
+            char ch = vt.cells[row][col].ch;
+            text[length++] = (ch >= ' ' && ch < 0x7F) ? ch : '?';
+        }
+        length += sprintf(text + length, "|\n");
+    }
+    for (uint8_t row = 0; row < SCREEN_ROWS; row++) {
+        char codes[SCREEN_COLS];
+        bool any = false;
+        for (uint8_t col = 0; col < SCREEN_COLS; col++) {
+            ScreenCell cell = vt.cells[row][col];
+            uint8_t attr = (cell.ch == ' ' && !(cell.attr & ATTR_UNDERLINE)) ? 0 : cell.attr;
+            codes[col] = attr_codes[attr & 0x3F];
+            any = any || attr != 0;
+        }
+        if (any) {
+            length += sprintf(text + length, "%2u |%.*s|\n", row + 1, SCREEN_COLS, codes);
+        }
+    }
+    text[length] = '\0';
+}
+
+//the step is over, its screen is taken when the wire gets there. the session goes straight on,
+//as main.c does, so the painting and draws still going out count against the next prompt
+static void show_step(void) {
+    steps[step_count - 1].end = USART_tx_stats().queued;
+    steps[step_count - 1].over = true;
+    take_screens();
+}
+
+//wait as wait_for_input() does until the prompt just printed is all on the terminal
+static void prompt_shown(void) {
+    uint32_t mark = USART_tx_stats().queued;
+    while (wire.sent < mark) {
+        tick(wire.now + 1e9, true);
+    }
+    uint32_t latency = (uint32_t)(wire.now - answered);
+    Step *step = &steps[step_count - 1];
+    step->latency_us = (latency > step->latency_us) ? latency : step->latency_us;
+}
+
+//the USART2 interrupt echoing a key
+static void echo(char key, uint8_t *length) {
+    UsartRegion region = USART_tx_region(REGION_PROMPT);
+    wire.in_interrupt = true;
+    if (key == '\b') {
+        if (*length > 0) {
+            USART_ESC_Code(LEFT_1);
+            USART_print_char(' ');
+            USART_ESC_Code(LEFT_1);
+            (*length)--;
+        }
+    } else if (*length < INPUT_SIZE - 1) {
+        input[(*length)++] = key;
+        USART_print_char(key);
+    }
+    wire.in_interrupt = false;
+    USART_tx_region(region);
+}
+
+//the player reads the prompt, types keys ('\b' for backspace) and presses Enter
+static void reply(const char *keys) {
+    prompt_shown();
+    uint8_t length = 0;
+    for (; *keys != '\0'; keys++) {
+        run_until(wire.now + KEY_US, true);
+        echo(*keys, &length);
+    }
+    run_until(wire.now + KEY_US, true);
+    input[length] = '\0';
+    answered = wire.now;
+}
+
+//a question on the prompt line where the cursor has been left
+static void ask(const char *question) {
+    USART_ESC_Code(CLEAR_LINE);
+    USART_ESC_Code(FULLY_LEFT);
+    USART_print_string(question);
+}
+
+//a question on the prompt line from anywhere
+static void ask_bottom(const char *question) {
+    USART_ESC_Code(TOP_LEFT);
+    USART_ESC_Code(DOWN_35);
+    USART_ESC_Code(CLEAR_LINE);
+    USART_print_string(question);
+}
+
+static void message(const char *text) {
+    ask(text);
+    pause(DEL_US);
+}
+
+//power up and INIT_ST, answered is 0 so the first prompt is timed from power up
+static void init_state(void) {
+    begin_step(ST_INIT);
+    USART_init();
+    player_chips = starting_chips;
+    bet_slip_clear(&bet_slip);
+    USART_start_screen();
+    USART_print_wheel(wheel_arr, 0);
+    USART_print_table(0);
+    USART_print_chips(&player_chips, bet_slip_total(&bet_slip));
+    host_primask = 0;
+    ask_bottom("Welcome to Roulette! Press Enter to begin.");
+    reply("");
+    message("Starting game...");
+    USART_tx_flush();
+    show_step();
+}
+
+//TRADE_ST, trading a $100 chip for $25 ones first if asked to
+static void trade_state(bool trade) {
+    begin_step(ST_TRADE);
+    if (trade) {
+        ask("Trade in chips? (yes/no) --> ");
+        reply("yes");
+        ask("Enter chip value to trade in --> ");
+        reply("100");
+        uint32_t value_in = (uint32_t)atoi(input);
+        USART_ESC_Code(CLEAR_LINE);
+        USART_ESC_Code(FULLY_LEFT);
+        USART_print_string("Enter quantity of ");
+        USART_print_currency(value_in);
+        USART_print_string(" chips to trade in --> ");
+        reply("1");
+        uint32_t quantity_in = (uint32_t)atoi(input);
+        ask("Enter chip value you want in return --> ");
+        reply("25");
+        uint32_t value_out = (uint32_t)atoi(input);
+        uint32_t quantity_out = (quantity_in * value_in) / value_out;
+        *get_chip_pointer(value_in, &player_chips) -= quantity_in;
+        *get_chip_pointer(value_out, &player_chips) += quantity_out;
+        USART_print_chips(&player_chips, bet_slip_total(&bet_slip));
+        USART_ESC_Code(TOP_LEFT);
+        USART_ESC_Code(DOWN_35);
+        USART_ESC_Code(CLEAR_LINE);
+        USART_ESC_Code(FULLY_LEFT);
+        USART_print_string("Trade in complete! You traded ");
+        USART_print_number(quantity_in);
+        USART_print_char(' ');
+        USART_print_currency(value_in);
+        USART_print_string(" chips for ");
+        USART_print_number(quantity_out);
+        USART_print_char(' ');
+        USART_print_currency(value_out);
+        USART_print_string(" chips.");
+        pause(2 * DEL_US);
+    }
+    ask("Trade in chips? (yes/no) --> ");
+    reply("no");
+    show_step();
+}
+
+//BET_TYPE_ST and the number asked by handle_double_array_bet()
+static void bet_type_state(const char *type, const char *number) {
+    begin_step(ST_BET_TYPE);
+    ask("Choose your bet type (from above) --> ");
+    reply(type);
+    BetType bet_type = parse_bet_type(input);
+    switch (bet_type) {
+        case BET_STRAIGHT:
+            ask("Enter number (" POCKET_RANGE ") --> ");
+            reply(number);
+            bet_id = bet_type_first_id[BET_STRAIGHT] + spot_to_pocket(input);
+            break;
+        case BET_SPLIT:
+        case BET_STREET:
+        case BET_BASKET:
+        case BET_CORNER:
+        case BET_DOUBLE_STREET:
+        case BET_DOZEN:
+        case BET_COLUMN:
+            USART_ESC_Code(CLEAR_LINE);
+            USART_ESC_Code(FULLY_LEFT);
+            USART_print_string("Enter ");
+            USART_print_string(bet_type_names[bet_type]);
+            USART_print_string(" number (refer to user manual or table) --> ");
+            reply(number);
+            bet_id = bet_type_first_id[bet_type] + (uint8_t)(atoi(input) - 1);
+            break;
+        case BET_TYPE_NONE:
+            message("Invalid bet type! Choose one from the list above.");
+            break;
+        default:
+            bet_id = bet_type_first_id[bet_type];
+    }
+    show_step();
+}
+
+static void table_update_state(void) {
+    begin_step(ST_TABLE_UPDATE);
+    USART_print_table(bet_pockets[bet_id] | bet_slip_pockets(&bet_slip));
+    show_step();
+}
+
+//BET_MONEY_ST staking lots of a chip value and a quantity each, then asked for another bet
+static void bet_money_state(const char *const *lots, bool another) {
+    begin_step(ST_BET_MONEY);
+    uint32_t total_bet = 0;
+    uint32_t slip_total = bet_slip_total(&bet_slip);
+    for (; *lots != NULL; lots += 2) {
+        ask_bottom("Enter chip value to bet or 'done' --> ");
+        reply(lots[0]);
+        uint32_t value = (uint32_t)atoi(input);
+        ask("Enter quantity of chips --> ");
+        reply(lots[1]);
+        uint32_t quantity = (uint32_t)atoi(input);
+        total_bet += value * quantity;
+        *get_chip_pointer(value, &player_chips) -= quantity;
+        USART_print_chips(&player_chips, slip_total + total_bet);
+    }
+    ask_bottom("Enter chip value to bet or 'done' --> ");
+    reply("done");
+    bet_slip_add(&bet_slip, bet_id, total_bet);
+    if (!bet_slip_full(&bet_slip) && calculate_total_balance(player_chips) > 0) {
+        ask("Place another bet? (yes/no) --> ");
+        reply(another ? "yes" : "no");
+    }
+    show_step();
+}
+
+//SPIN_ST from fixed launch words, the frames drawn as the main loop draws them at the frame rate
+static void spin_state(void) {
+    static const uint32_t launch_words[PHYSICS_WORDS] = {0x9E3779B9, 0x7F4A7C15, 0xF39CC060, 0x5CEDC834,
+                                                         0x2FE12A6D, 0x1B873593};
+    begin_step(ST_SPIN);
+    ask("Press Enter to spin the wheel...");
+    reply("");
+    ask("Spinning...");
+    WheelSpin spin;
+    physics_launch(&spin, &wheel_physics, launch_words);
+    physics_land_on(&spin, WIN_INDEX);
+    SpinPacing pacing;
+    pacing_init(&pacing, spin.rest_step, SPIN_DURATION_MS, SPIN_EASE);
+    double launch = wire.now;
+    for (uint32_t frame = 1; frame < pacing.frames; frame++) {
+        run_until(launch + (frame * 1e6 / PHYSICS_FRAME_HZ), false);
+        UsartTxStats tx = USART_tx_stats();
+        spin_stats.posted++;
+        if (pacing_draw(tx.queued - tx.sent, SPIN_TX_BUDGET, frame + 1 == pacing.frames)) {
+            USART_print_wheel(wheel_arr, physics_index_at(&spin, pacing_step(&pacing, frame)));
+            spin_stats.drawn++;
+        } else {
+            spin_stats.dropped++;
+        }
+    }
+    show_step();
+}
+
+//RESULT_ST, without the wheel bias check, which no single spin can set off
+static void result_state(void) {
+    begin_step(ST_RESULT);
+    USART_print_table(0);
+    uint32_t staked = bet_slip_total(&bet_slip);
+    uint32_t winnings = bet_slip_resolve(&bet_slip, wheel_arr[WIN_INDEX]);
+    if (winnings > 0) {
+        distribute_chips(winnings, &player_chips);
+    }
+    bet_slip_clear(&bet_slip);
+    USART_print_chips(&player_chips, bet_slip_total(&bet_slip));
+    USART_ESC_Code(TOP_LEFT);
+    USART_ESC_Code(DOWN_35);
+    USART_ESC_Code(CLEAR_LINE);
+    USART_ESC_Code(FULLY_LEFT);
+    USART_ESC_Code(RESET_ATTRIBUTES);
+    if (winnings > staked) {
+        USART_print_string("Congratulations! You won ");
+        USART_print_currency(winnings - staked);
+        USART_print_string("! ");
+    } else if (winnings == staked) {
+        USART_print_string("Better luck next time! You broke even. ");
+    } else {
+        USART_print_string("Better luck next time! You lost ");
+        USART_print_currency(staked - winnings);
+        USART_print_string(". ");
+    }
+    pause(2.5 * DEL_US);
+    show_step();
+}
+
+static void end_state(void) {
+    begin_step(ST_END);
+    USART_print_string("Press Enter to play again!");
+    reply("");
+    show_step();
+}
+
+//the transmit report typed at the last prompt of the session, as wait_for_input() answers it,
+//on a terminal as wide as the game. every line must fit without wrapping, and neither the report
+//nor the echo of the command may count against the game's counters
+static bool check_tx_report(void) {
+    static uint32_t before[USART_TX_STATES][NUM_REGIONS];
+    for (uint8_t state = 0; state < USART_TX_STATES; state++) {
+        for (uint8_t region = 0; region < NUM_REGIONS; region++) {
+            before[state][region] = USART_tx_region_bytes(state, region);
+        }
+    }
+    vt_init(&vt, SCREEN_COLS);
+    USART_tx_input_start();
+    uint8_t length = 0;
+    for (const char *key = TX_REPORT_COMMAND; *key != '\0'; key++) {
+        run_until(wire.now + KEY_US, true);
+        echo(*key, &length);
+    }
+    USART_open_tx_report(state_names, &spin_stats);
+    USART_tx_flush();
+    uint32_t rows = vt.cursor.row + 1;
+    bool shown = vt.alternate;
+    USART_close_tx_report();
+    USART_tx_flush();
+    uint32_t changed = 0;
+    for (uint8_t state = 0; state < USART_TX_STATES; state++) {
+        for (uint8_t region = 0; region < NUM_REGIONS; region++) {
+            changed += (USART_tx_region_bytes(state, region) != before[state][region]);
+        }
+    }
+    bool passed = shown && !vt.alternate && vt.wraps == 0 && changed == 0;
+    printf("tx report on a %u column terminal: %u rows, %u wrapped lines, %u counters changed by it: %s\n",
+           vt.cols, rows, vt.wraps, changed, passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+//the fixed session, two bets on a round that wins and the start of the next
+static void play_session(void) {
+    static const char *const first_lots[] = {"25", "2", "5", "1", NULL};
+    static const char *const second_lots[] = {"10", "3", NULL};
+    init_state();
+    trade_state(true);
+    bet_type_state("Straight", spot_labels[wheel_arr[WIN_INDEX]]);
+    table_update_state();
+    bet_money_state(first_lots, true);
+    bet_type_state("Splt\bit", "12");
+    table_update_state();
+    bet_money_state(second_lots, false);
+    spin_state();
+    result_state();
+    end_state();
+    trade_state(false);
+    bet_type_state("Voisins", "");
+    close_step();
+    USART_tx_flush();
+}
+
+static char *read_file(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return NULL;
+    }
+    char *text = malloc(GOLDEN_SIZE);
+    size_t length = fread(text, 1, GOLDEN_SIZE - 1, file);
+    text[length] = '\0';
+    fclose(file);
+    return text;
+}
+
+//split the golden text into its steps, returns how many
+static uint8_t parse_golden(const char *text, GoldenStep *golden) {
+    uint8_t count = 0;
+    const char *line = strstr(text, "\n== ");
+    while (line != NULL && count < MAX_STEPS) {
+        GoldenStep *step = &golden[count];
+        if (sscanf(line + 1, "== %*u %15[^:]: %u bytes, %u us", step->state, &step->bytes, &step->latency_us) != 3) {
+            break;
+        }
+        step->screen = strchr(line + 1, '\n') + 1;
+        line = strstr(step->screen - 1, "\n== ");
+        step->screen_length = (line != NULL) ? (size_t)(line + 1 - step->screen) : strlen(step->screen);
+        count++;
+    }
+    return count;
+}
+
+static bool write_golden(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        return false;
+    }
+    fprintf(file, "//terminal screens of the %s wheel session of Tools/screen_check.c, recorded with -u.\n", WHEEL_NAME);
+    fprintf(file, "//a step is its game state, the bytes it sent and its latency, then the cursor, the rows\n");
+    fprintf(file, "//and the attributes of the rows that have any, a character of attr_codes per cell\n");
+    for (uint8_t i = 0; i < step_count; i++) {
+        fprintf(file, "== %u %s: %u bytes, %u us\n%s", i + 1, state_names[steps[i].state], steps[i].bytes,
+                steps[i].latency_us, steps[i].screen);
+    }
+    return fclose(file) == 0;
+}
+
+//print the first line of a step's screen that differs from its golden copy
+static void print_difference(const Step *step, const GoldenStep *golden) {
+    const char *now = step->screen;
+    const char *was = golden->screen;
+    const char *was_end = golden->screen + golden->screen_length;
+    while (*now != '\0' && was < was_end) {
+        size_t now_length = strcspn(now, "\n");
+        size_t was_length = strcspn(was, "\n");
+        if (now_length != was_length || memcmp(now, was, now_length) != 0) {
+            break;
+        }
+        now += now_length + (now[now_length] != '\0');
+        was += was_length + 1;
+    }
+    printf("    golden: %.*s\n    now:    %.*s\n", (int)((was < was_end) ? strcspn(was, "\n") : 0), was,
+           (int)strcspn(now, "\n"), now);
+}
+
+//every step against the golden file, returns whether all match and keep to their budgets
+static bool compare(const GoldenStep *golden, uint8_t golden_count) {
+    bool passed = (golden_count == step_count);
+    printf("%-4s %-13s %8s %8s %10s %10s  %s\n", "step", "state", "bytes", "budget", "latency", "budget", "screen");
+    for (uint8_t i = 0; i < step_count; i++) {
+        const Step *step = &steps[i];
+        if (i >= golden_count || strcmp(golden[i].state, state_names[step->state]) != 0) {
+            printf("%-4u %-13s %8u %8s %10.1f %10s  not in the golden file\n", i + 1, state_names[step->state],
+                   step->bytes, "-", step->latency_us / 1000.0, "-");
+            passed = false;
+            continue;
+        }
+        bool same = strlen(step->screen) == golden[i].screen_length
+                    && memcmp(step->screen, golden[i].screen, golden[i].screen_length) == 0;
+        bool bytes_ok = step->bytes <= golden[i].bytes;
+        bool latency_ok = step->latency_us <= golden[i].latency_us;
+        printf("%-4u %-13s %8u %8u %7.1f ms %7.1f ms  %s%s%s\n", i + 1, state_names[step->state], step->bytes,
+               golden[i].bytes, step->latency_us / 1000.0, golden[i].latency_us / 1000.0, same ? "same" : "DIFFERS",
+               bytes_ok ? "" : ", OVER BYTE BUDGET", latency_ok ? "" : ", OVER LATENCY BUDGET");
+        if (!same) {
+            print_difference(step, &golden[i]);
+        }
+        passed = passed && same && bytes_ok && latency_ok;
+    }
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    const char *path = "Tools/screens/" VARIANT ".txt";
+    bool record = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-u") == 0) {
+            record = true;
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [-u] [-f golden file]\n", argv[0]);
+            return 2;
+        }
+    }
+    vt_init(&vt, VT_COLS);
+    play_session();
+    if (vt.unknown > 0) {
+        printf("FAIL: the terminal did not follow %u codes, the first %s\n", vt.unknown, vt.first_unknown);
+        return 1;
+    }
+    if (blank_start_rows > 0) {
+        printf("FAIL: %u rows of the start screen were still blank when the game left INIT\n", blank_start_rows);
+        return 1;
+    }
+    if (!check_tx_report() || vt.unknown > 0) {
+        printf("FAIL%s\n", (vt.unknown > 0) ? ", the terminal did not follow the report" : "");
+        return 1;
+    }
+    if (record) {
+        if (!write_golden(path)) {
+            fprintf(stderr, "screen_check: cannot write %s\n", path);
+            return 2;
+        }
+        printf("recorded %u screens of the %s wheel to %s\n", step_count, WHEEL_NAME, path);
+        return 0;
+    }
+    char *text = read_file(path);
+    if (text == NULL) {
+        fprintf(stderr, "screen_check: cannot read %s, record it with -u\n", path);
+        return 2;
+    }
+    static GoldenStep golden[MAX_STEPS];
+    uint8_t golden_count = parse_golden(text, golden);
+    printf("%u steps of the %s wheel session against %s at %u baud\n\n", step_count, WHEEL_NAME, path, BAUD_RATE);
+    bool passed = compare(golden, golden_count);
+    printf("\n%s\n", passed ? "PASS" : "FAIL");
+    free(text);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+//start screen generator, runs on the build host before the firmware is compiled
+//
+//draws the fixed part of the screen (title, wheel, table and bottom container outlines,
+//payout headings and chip values) into a Screen with screen.c, packs its cells with the run
+//length code described in screen.h and writes them to start_screen_<wheel>.c, which
+//screen_load() unpacks at boot instead of the firmware holding every outline line as text.
+//the packed cells are unpacked again and checked against the drawing, a mismatch fails the
+//build. reports the bytes of flash the outline text took and what the packed screen takes.
+//
+//run once per wheel variant, each run writes its own file (compiled only when WHEEL_ZEROS
+//matches).
+//
+//build and run (from the repository root):
+//  for zeros in 1 2 3; do
+//    gcc -O2 -DWHEEL_ZEROS=$zeros -ICore/Src Tools/screen_gen.c Core/Src/screen.c -o screen_gen && ./screen_gen Core/Src
+//  done
+#include "spots.h"
+#include "screen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WHEEL_OUTLINE 4 //number of lines in wheel outline
+#define TABLE_OUTLINE 16 //number of lines in table outline
+#define BOTTOM_OUTLINE 11 //number of lines in bottom container outline
+#define CHIP_LABELS 7 //colored chip values on the chips panel
+#define SCREEN_CELLS (SCREEN_ROWS * SCREEN_COLS)
+#define MAX_LITERAL SCREEN_PACK_REPEAT //bytes one literal control byte can carry
+#define MIN_REPEAT 3 //shortest run worth a repeat
+#define MAX_REPEAT (255 - SCREEN_PACK_REPEAT + MIN_REPEAT) //longest run one repeat can carry
+
+//screen rows and columns, 1 based
+#define TITLE_ROW 1
+#define TITLE_COL 32
+#define WHEEL_OUTLINE_ROW 4
+#define TABLE_OUTLINE_ROW 10
+#define PAYOUTS_ROW 26 //bottom container headings
+#define BOTTOM_OUTLINE_ROW 27
+
+#if WHEEL_ZEROS == 1
+#define VARIANT "single" //output file suffix
+#elif WHEEL_ZEROS == 2
+#define VARIANT "double"
+#else
+#define VARIANT "triple"
+#endif
+
+//zero column borders beside the 3rd row of numbers and the lines under the 3rd and 2nd
+//rows, the zeros share the three rows between them
+#if WHEEL_ZEROS == 1
+#define ZERO_EDGE_UPPER "|  "
+#define ZERO_EDGE_MIDDLE "|  "
+#define ZERO_EDGE_LOWER "|  "
+#define TOP_LINE_ODDS "8" //to 1
+#elif WHEEL_ZEROS == 2
+#define ZERO_EDGE_UPPER "|  "
+#define ZERO_EDGE_MIDDLE "|--"
+#define ZERO_EDGE_LOWER "|  "
+#define TOP_LINE_ODDS "6"
+#else
+#define ZERO_EDGE_UPPER "|--"
+#define ZERO_EDGE_MIDDLE "|  "
+#define ZERO_EDGE_LOWER "|--"
+#define TOP_LINE_ODDS "5"
+#endif
+
+//text drawn at a fixed place in one color
+typedef struct {
+    uint8_t row; //1 based
+    uint8_t col;
+    uint8_t attr;
+    const char *text;
+} ScreenText;
+
+static const char *wheel_outline[] = { //outline for wheel
+    "				 ####",
+    "	     -------------------|----|-------------------",
+    "	         |    |    |    |    |    |    |    |    ",
+    "	     -------------------|----|-------------------"
+};
+
+static const char *table_outline[] = { //outline for table
+    "   -------------------------------------------------------------",
+    "   |            1 - 18           |           19 - 36           |",
+    "---|-----------------------------|-----------------------------|------",
+    "|  |    |    |    |    |    |    |    |    |    |    |    |    | 3rd |",
+    ZERO_EDGE_UPPER "|----|----|----|----|----|----|----|----|----|----|----|----|-----|",
+    ZERO_EDGE_MIDDLE "|    |    |    |    |    |    |    |    |    |    |    |    | 2nd |",
+    ZERO_EDGE_LOWER "|----|----|----|----|----|----|----|----|----|----|----|----|-----|",
+    "|  |    |    |    |    |    |    |    |    |    |    |    |    | 1st |",
+    "---|-------------------|-------------------|-------------------|------",
+    "   |       1 - 12      |      13 - 24      |      25 - 36      |",
+    "   |-----------------------------------------------------------|",
+    "   |     EVEN     |     RED      |    BLACK     |     ODD      |",
+    "   -------------------------------------------------------------",
+    "                                                        --------------",
+    "                                                        |BET: $      |",
+    "                                                        --------------"
+};
+
+static const char *bottom_container_outline[] = { //outline for bottom container
+    "---------------------------------------------    ---------------------",
+    "| Straight: 35 to 1 | Double Street: 5 to 1 |    |     :   |   :     |",
+    "| Split: 17 to 1    | Dozen: 2 to 1         |    |    :    |   :     |",
+    "| Street: 11 to 1   | Column: 2 to 1        |    |    :    |  :      |",
+    "| Basket: 11 to 1   | Red/Black: 1 to 1     |    |   :     |$1:      |",
+    "| Corner: 8 to 1    | Odd/Even: 1 to 1      |    ---------------------",
+    "| Top Line: " TOP_LINE_ODDS " to 1  | Low/High: 1 to 1      |    |BALANCE: $         |",
+    "---------------------------------------------    ---------------------",
+    "----------------------------------------------------------------------",
+    "", //prompt line
+    "----------------------------------------------------------------------"
+};
+
+static const char title[] = "ROULETTE";
+static const char payouts_heading[] = "             BETTING PAYOUTS                             CHIPS";
+
+//chip values beside their counts
+static const ScreenText chip_labels[CHIP_LABELS] = {
+    {28, 51, COLOR_YELLOW, "$1000"},
+    {28, 61, COLOR_GREEN, "$25"},
+    {29, 51, COLOR_PURPLE, "$500"},
+    {29, 61, COLOR_BLUE, "$10"},
+    {30, 51, COLOR_BLACK, "$100"},
+    {30, 61, COLOR_RED, "$5"},
+    {31, 51, COLOR_ORANGE, "$50"}
+};
+
+static Screen screen;
+static uint8_t packed[4 * SCREEN_CELLS]; //far more than any packing of two planes takes
+
+//draw a section line by line from a screen row, returns the flash its text takes
+static size_t draw_section(const char **lines, uint8_t count, uint8_t row) {
+    size_t bytes = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        screen_put(&screen, row + i, 1, lines[i], 0);
+        bytes += strlen(lines[i]) + 1 + sizeof(lines[i]);
+    }
+    return bytes;
+}
+
+//bytes from first up to end taken every stride-th byte from cells as literals onto the end of
+//packed, returns the new end
+static size_t pack_literals(const uint8_t *cells, uint32_t stride, uint32_t first, uint32_t end, size_t out) {
+    while (first < end) {
+        uint32_t length = (end - first < MAX_LITERAL) ? end - first : MAX_LITERAL;
+        packed[out++] = (uint8_t)(length - 1);
+        for (uint32_t n = 0; n < length; n++) {
+            packed[out++] = cells[(first + n) * stride];
+        }
+        first += length;
+    }
+    return out;
+}
+
+//pack count bytes taken every stride-th byte from cells onto the end of packed, returns the new
+//end: runs of MIN_REPEAT or more as repeats, everything between as literals
+static size_t pack(const uint8_t *cells, uint32_t stride, uint32_t count, size_t out) {
+    uint32_t literal = 0; //first byte not packed yet
+    uint32_t i = 0;
+    while (i < count) {
+        uint32_t run = 1;
+        while (i + run < count && run < MAX_REPEAT && cells[(i + run) * stride] == cells[i * stride]) {
+            run++;
+        }
+        if (run < MIN_REPEAT) {
+            i++;
+            continue;
+        }
+        out = pack_literals(cells, stride, literal, i, out);
+        packed[out++] = (uint8_t)(SCREEN_PACK_REPEAT + run - MIN_REPEAT);
+        packed[out++] = cells[i * stride];
+        i += run;
+        literal = i;
+    }
+    return pack_literals(cells, stride, literal, count, out);
+}
+
+//open an output file inside the output directory
+static FILE *open_output(const char *dir, const char *name) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "screen_gen: cannot write %s\n", path);
+        exit(1);
+    }
+    return file;
+}
+
+int main(int argc, char **argv) {
+    const char *out_dir = (argc > 1) ? argv[1] : ".";
+
+    //draw the start screen the way the firmware used to, counting the flash its text took
+    screen_init(&screen);
+    size_t text_bytes = 0;
+    screen_put(&screen, TITLE_ROW, TITLE_COL, title, ATTR_BOLD | ATTR_UNDERLINE);
+    text_bytes += sizeof(title);
+    text_bytes += draw_section(wheel_outline, WHEEL_OUTLINE, WHEEL_OUTLINE_ROW);
+    text_bytes += draw_section(table_outline, TABLE_OUTLINE, TABLE_OUTLINE_ROW);
+    screen_put(&screen, PAYOUTS_ROW, 1, payouts_heading, ATTR_BOLD);
+    text_bytes += sizeof(payouts_heading);
+    text_bytes += draw_section(bottom_container_outline, BOTTOM_OUTLINE, BOTTOM_OUTLINE_ROW);
+    for (uint8_t i = 0; i < CHIP_LABELS; i++) {
+        screen_put(&screen, chip_labels[i].row, chip_labels[i].col, chip_labels[i].text, chip_labels[i].attr);
+        text_bytes += strlen(chip_labels[i].text) + 1 + sizeof(ScreenText);
+    }
+
+    //characters then attributes, row by row
+    size_t length = pack((const uint8_t *)&screen.cells[0][0].ch, sizeof(ScreenCell), SCREEN_CELLS, 0);
+    size_t chars_length = length;
+    length = pack(&screen.cells[0][0].attr, sizeof(ScreenCell), SCREEN_CELLS, length);
+
+    //the firmware must unpack exactly what was drawn
+    static Screen loaded;
+    screen_init(&loaded);
+    screen_load(&loaded, packed);
+    if (memcmp(loaded.cells, screen.cells, sizeof(screen.cells)) != 0) {
+        fprintf(stderr, "screen_gen: packed screen does not unpack to the drawing\n");
+        return 1;
+    }
+
+    FILE *source = open_output(out_dir, "start_screen_" VARIANT ".c");
+    fprintf(source, "//generated by Tools/screen_gen.c (%s wheel), do not edit\n", WHEEL_NAME);
+    fprintf(source, "#include \"spots.h\"\n#include \"screen.h\"\n\n#if WHEEL_ZEROS == %u\n\n", WHEEL_ZEROS);
+    fprintf(source, "//cells of the start screen packed for screen_load(), %zu bytes of characters then %zu of\n",
+            chars_length, length - chars_length);
+    fprintf(source, "//attributes for %u cells\n", SCREEN_CELLS);
+    fprintf(source, "const uint8_t start_screen_packed[%zu] = {\n", length);
+    for (size_t i = 0; i < length; i++) {
+        fprintf(source, "%s0x%02X%s", (i % 16 == 0) ? "    " : "", packed[i],
+                (i + 1 < length) ? ((i % 16 == 15) ? ",\n" : ", ") : "\n");
+    }
+    fprintf(source, "};\n\n#endif\n");
+    fclose(source);
+
+    printf("%s wheel: outline text %zu bytes, packed screen %zu bytes (%zu characters, %zu attributes)\n",
+           WHEEL_NAME, text_bytes, length, chars_length, length - chars_length);
+    return 0;
+}
@@ -0,0 +1,279 @@
+//shared pieces of the host simulation tools: random streams, threads and timing
+#include "sim.h"
+#include <immintrin.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+//splitmix64 step, used to expand a seed into generator state
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+//Philox4x32-10 constants (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+#define PHILOX_LANES 16 //blocks computed side by side by sim_rng_fill
+
+//one Philox4x32-10 block: four random words from a 128-bit counter and a 64-bit key
+void sim_philox(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (uint8_t r = 0; r < PHILOX_ROUNDS; r++) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+        c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (uint32_t)p1;
+        c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (uint32_t)p0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+//PHILOX_LANES consecutive blocks of a stream, one at a time
+static void philox_lanes_scalar(const uint32_t key[2], uint64_t block, const uint32_t stream[2], uint32_t *out) {
+    for (uint32_t i = 0; i < PHILOX_LANES; i++) {
+        uint32_t counter[4] = {(uint32_t)(block + i), (uint32_t)((block + i) >> 32), stream[0], stream[1]};
+        sim_philox(counter, key, out + (4 * i));
+    }
+}
+
+//the vector kernels keep each 32-bit word in the low half of a 64-bit lane, so one
+//unsigned 32x32 multiply gives the full product and the upper halves can hold garbage
+//until the words are packed back into block order at the end
+__attribute__((target("avx2")))
+static void philox_lanes_avx2(const uint32_t key[2], uint64_t block, const uint32_t stream[2], uint32_t *out) {
+    const __m256i m0 = _mm256_set1_epi64x(PHILOX_M0);
+    const __m256i m1 = _mm256_set1_epi64x(PHILOX_M1);
+    __m256i c0[PHILOX_LANES / 4], c1[PHILOX_LANES / 4], c2[PHILOX_LANES / 4], c3[PHILOX_LANES / 4];
+    for (uint32_t v = 0; v < PHILOX_LANES / 4; v++) {
+        __m256i b = _mm256_add_epi64(_mm256_set1_epi64x((int64_t)block), _mm256_setr_epi64x(4 * v, (4 * v) + 1, (4 * v) + 2, (4 * v) + 3));
+        c0[v] = b;
+        c1[v] = _mm256_srli_epi64(b, 32);
+        c2[v] = _mm256_set1_epi64x(stream[0]);
+        c3[v] = _mm256_set1_epi64x(stream[1]);
+    }
+    uint32_t k0 = key[0], k1 = key[1];
+    for (uint8_t r = 0; r < PHILOX_ROUNDS; r++) {
+        const __m256i key0 = _mm256_set1_epi64x(k0);
+        const __m256i key1 = _mm256_set1_epi64x(k1);
+        for (uint32_t v = 0; v < PHILOX_LANES / 4; v++) {
+            __m256i p0 = _mm256_mul_epu32(c0[v], m0);
+            __m256i p1 = _mm256_mul_epu32(c2[v], m1);
+            c0[v] = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1[v]), key0);
+            c1[v] = p1;
+            c2[v] = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3[v]), key1);
+            c3[v] = p0;
+        }
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    const __m256i low = _mm256_set1_epi64x(0xFFFFFFFF);
+    for (uint32_t v = 0; v < PHILOX_LANES / 4; v++) {
+        //(c0, c1) and (c2, c3) as 64-bit halves of each block, then blocks back in order
+        __m256i x01 = _mm256_or_si256(_mm256_and_si256(c0[v], low), _mm256_slli_epi64(c1[v], 32));
+        __m256i x23 = _mm256_or_si256(_mm256_and_si256(c2[v], low), _mm256_slli_epi64(c3[v], 32));
+        __m256i even = _mm256_unpacklo_epi64(x01, x23);
+        __m256i odd = _mm256_unpackhi_epi64(x01, x23);
+        _mm256_storeu_si256((__m256i *)(out + (16 * v)), _mm256_permute2x128_si256(even, odd, 0x20));
+        _mm256_storeu_si256((__m256i *)(out + (16 * v) + 8), _mm256_permute2x128_si256(even, odd, 0x31));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void philox_lanes_avx512(const uint32_t key[2], uint64_t block, const uint32_t stream[2], uint32_t *out) {
+    const __m512i m0 = _mm512_set1_epi64(PHILOX_M0);
+    const __m512i m1 = _mm512_set1_epi64(PHILOX_M1);
+    __m512i c0[PHILOX_LANES / 8], c1[PHILOX_LANES / 8], c2[PHILOX_LANES / 8], c3[PHILOX_LANES / 8];
+    for (uint32_t v = 0; v < PHILOX_LANES / 8; v++) {
+        __m512i b = _mm512_add_epi64(_mm512_set1_epi64((int64_t)block + (8 * v)), _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7));
+        c0[v] = b;
+        c1[v] = _mm512_srli_epi64(b, 32);
+        c2[v] = _mm512_set1_epi64(stream[0]);
+        c3[v] = _mm512_set1_epi64(stream[1]);
+    }
+    uint32_t k0 = key[0], k1 = key[1];
+    for (uint8_t r = 0; r < PHILOX_ROUNDS; r++) {
+        const __m512i key0 = _mm512_set1_epi64(k0);
+        const __m512i key1 = _mm512_set1_epi64(k1);
+        for (uint32_t v = 0; v < PHILOX_LANES / 8; v++) {
+            __m512i p0 = _mm512_mul_epu32(c0[v], m0);
+            __m512i p1 = _mm512_mul_epu32(c2[v], m1);
+            c0[v] = _mm512_ternarylogic_epi64(_mm512_srli_epi64(p1, 32), c1[v], key0, 0x96);
+            c1[v] = p1;
+            c2[v] = _mm512_ternarylogic_epi64(_mm512_srli_epi64(p0, 32), c3[v], key1, 0x96);
+            c3[v] = p0;
+        }
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    const __m512i low = _mm512_set1_epi64(0xFFFFFFFF);
+    const __m512i first = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11);
+    const __m512i second = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15);
+    for (uint32_t v = 0; v < PHILOX_LANES / 8; v++) {
+        __m512i x01 = _mm512_or_si512(_mm512_and_si512(c0[v], low), _mm512_slli_epi64(c1[v], 32));
+        __m512i x23 = _mm512_or_si512(_mm512_and_si512(c2[v], low), _mm512_slli_epi64(c3[v], 32));
+        __m512i even = _mm512_unpacklo_epi64(x01, x23);
+        __m512i odd = _mm512_unpackhi_epi64(x01, x23);
+        _mm512_storeu_si512(out + (32 * v), _mm512_permutex2var_epi64(even, first, odd));
+        _mm512_storeu_si512(out + (32 * v) + 16, _mm512_permutex2var_epi64(even, second, odd));
+    }
+}
+
+typedef void (*PhiloxLanes)(const uint32_t[2], uint64_t, const uint32_t[2], uint32_t *);
+
+//widest kernel the CPU runs, picked on first use
+static PhiloxLanes philox_lanes_best(void) {
+    static PhiloxLanes best = NULL;
+    if (best == NULL) {
+        __builtin_cpu_init();
+        best = __builtin_cpu_supports("avx512f") ? philox_lanes_avx512
+             : __builtin_cpu_supports("avx2") ? philox_lanes_avx2 : philox_lanes_scalar;
+    }
+    return best;
+}
+
+//seed a stream, every (seed, stream) pair gives an independent sequence: the seed picks the
+//key and the stream the upper half of the counter, so streams never share a counter value
+void sim_rng_seed(SimRng *rng, uint64_t seed, uint64_t stream) {
+    uint64_t key = splitmix64(&seed);
+    rng->key[0] = (uint32_t)key;
+    rng->key[1] = (uint32_t)(key >> 32);
+    rng->counter[0] = 0;
+    rng->counter[1] = 0;
+    rng->counter[2] = (uint32_t)stream;
+    rng->counter[3] = (uint32_t)(stream >> 32);
+    rng->used = 4;
+}
+
+//next block of the stream, returns its first word
+uint32_t sim_rng_refill(SimRng *rng) {
+    sim_philox(rng->counter, rng->key, rng->block);
+    if (++rng->counter[0] == 0) {
+        rng->counter[1]++;
+    }
+    rng->used = 1;
+    return rng->block[0];
+}
+
+//fill words with the next count words of the stream, the same words sim_rng_next gives
+void sim_rng_fill(SimRng *rng, uint32_t *words, size_t count) {
+    size_t i = 0;
+    while (i < count && rng->used < 4) {
+        words[i++] = rng->block[rng->used++];
+    }
+    uint64_t block = ((uint64_t)rng->counter[1] << 32) | rng->counter[0];
+    PhiloxLanes lanes = philox_lanes_best();
+    while (count - i >= 4 * PHILOX_LANES) {
+        lanes(rng->key, block, &rng->counter[2], words + i);
+        block += PHILOX_LANES;
+        i += 4 * PHILOX_LANES;
+    }
+    rng->counter[0] = (uint32_t)block;
+    rng->counter[1] = (uint32_t)(block >> 32);
+    while (i < count) {
+        words[i++] = sim_rng_next(rng);
+    }
+}
+
+//run fn once per thread, thread i gets args + i * arg_size, returns 0 on success
+int sim_run_threads(uint32_t threads, void *(*fn)(void *), void *args, size_t arg_size) {
+    pthread_t *ids = malloc(threads * sizeof(pthread_t));
+    if (ids == NULL) {
+        return -1;
+    }
+    int status = 0;
+    uint32_t started = 0;
+    for (; started < threads; started++) {
+        if (pthread_create(&ids[started], NULL, fn, (char *)args + (started * arg_size)) != 0) {
+            status = -1;
+            break;
+        }
+    }
+    for (uint32_t i = 0; i < started; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    free(ids);
+    return status;
+}
+
+//wall clock in seconds
+double sim_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + (now.tv_nsec * 1e-9);
+}
+
+//parse a count such as 1000000, 1e9, 250M or 2G
+uint64_t sim_parse_count(const char *text) {
+    char *end;
+    double value = strtod(text, &end);
+    switch (*end) {
+        case 'k': case 'K': value *= 1e3; break;
+        case 'm': case 'M': value *= 1e6; break;
+        case 'g': case 'G': value *= 1e9; break;
+        default: break;
+    }
+    return (value > 0) ? (uint64_t)value : 0;
+}
+
+//structure to hold the shards one thread runs in a round
+typedef struct {
+    SimShardFn run; //runs one shard into its slot
+    void *ctx; //caller context
+    char *slots; //slots of the round, one per shard
+    size_t slot_size; //bytes per slot
+    uint64_t first; //first shard of the round
+    uint64_t count; //shards in the round
+    uint32_t offset; //first shard of this thread within the round
+    uint32_t stride; //threads in the round
+} ShardWorker;
+
+static void *shard_worker(void *arg) {
+    ShardWorker *worker = arg;
+    for (uint64_t i = worker->offset; i < worker->count; i += worker->stride) {
+        worker->run(worker->ctx, worker->first + i, worker->slots + (i * worker->slot_size));
+    }
+    return NULL;
+}
+
+//run shards 0..shards-1 on the threads a round at a time, then merge each shard's slot in
+//shard order on the calling thread. as long as a shard's result depends only on its index,
+//the merged result is the same for any thread count, and memory stays at one round of slots
+int sim_run_shards(uint32_t threads, uint64_t shards, SimShardFn run, SimShardFn merge, void *ctx, size_t slot_size) {
+    uint32_t window = threads * SHARDS_PER_THREAD;
+    size_t stride = (slot_size + 63) & ~(size_t)63;
+    char *slots = aligned_alloc(64, window * stride);
+    ShardWorker *workers = malloc(threads * sizeof(ShardWorker));
+    if (slots == NULL || workers == NULL) {
+        free(slots);
+        free(workers);
+        return -1;
+    }
+    int status = 0;
+    for (uint64_t first = 0; first < shards && status == 0; first += window) {
+        uint64_t count = (shards - first < window) ? shards - first : window;
+        uint32_t active = (count < threads) ? (uint32_t)count : threads;
+        for (uint32_t i = 0; i < active; i++) {
+            workers[i] = (ShardWorker) {run, ctx, slots, stride, first, count, i, active};
+        }
+        status = sim_run_threads(active, shard_worker, workers, sizeof(ShardWorker));
+        for (uint64_t i = 0; i < count && status == 0; i++) {
+            merge(ctx, first + i, slots + (i * stride));
+        }
+    }
+    free(slots);
+    free(workers);
+    return status;
+}
@@ -0,0 +1,43 @@
+#ifndef TOOLS_SIM_H_
+#define TOOLS_SIM_H_
+#include "payouts.h"
+#include <stddef.h>
+
+#define SHARDS_PER_THREAD 4 //shards each thread runs between merges
+
+//counter based random word stream (Philox4x32-10), one per thread, session or shard
+typedef struct {
+    uint32_t key[2]; //key from the seed
+    uint32_t counter[4]; //block number in words 0-1, stream in words 2-3
+    uint32_t block[4]; //words of the current block
+    uint8_t used; //words of the block already handed out
+} SimRng;
+
+//runs or merges one shard, ctx is the caller's, slot holds the shard's result
+typedef void (*SimShardFn)(void *ctx, uint64_t shard, void *slot);
+
+void sim_philox(const uint32_t[4], const uint32_t[2], uint32_t[4]);
+void sim_rng_seed(SimRng *, uint64_t, uint64_t);
+uint32_t sim_rng_refill(SimRng *);
+void sim_rng_fill(SimRng *, uint32_t *, size_t);
+int sim_run_threads(uint32_t, void *(*)(void *), void *, size_t);
+int sim_run_shards(uint32_t, uint64_t, SimShardFn, SimShardFn, void *, size_t);
+double sim_now(void);
+uint64_t sim_parse_count(const char *);
+
+//next 32-bit random word, stands in for RNG->DR
+static inline uint32_t sim_rng_next(SimRng *rng) {
+    return (rng->used < 4) ? rng->block[rng->used++] : sim_rng_refill(rng);
+}
+
+//map a random word to a wheel index without division, (word * ARR_SIZE) / 2^32
+static inline uint8_t spin_index(uint32_t word) {
+    return (uint8_t)(((uint64_t)word * ARR_SIZE) >> 32);
+}
+
+//spin the wheel, one random word per spin
+static inline Spot sim_spin(SimRng *rng) {
+    return wheel_arr[spin_index(sim_rng_next(rng))];
+}
+
+#endif
@@ -0,0 +1,152 @@
+//headless Monte Carlo spin engine, runs on the build host
+//
+//spins wheel_arr and settles a one unit bet of every bet type on every spin through the
+//generated payout matrix, spread across all cores. spins are drawn a block of random
+//words at a time and settled by the widest spin kernel the CPU supports (-k to force one).
+//reports return per unit staked, its variance and the run time for each bet type, the
+//same for any thread count.
+//
+//add -DWHEEL_ZEROS=1 or 3 to build for the single or triple zero wheel, the builds for each
+//wheel run side by side.
+//
+//build and run (from the repository root):
+//  gcc -O2 -pthread -ICore/Src -ITools Tools/simulate.c Tools/sim.c Tools/spin_kernel.c Core/Src/spots.c Core/Src/payouts_*.c -lm -o simulate
+//  ./simulate -n 1e9 -t 8 -s 1
+#include "spin_kernel.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define BLOCK_WORDS 16384 //random words drawn per block, one spin each
+
+//payout of every bet ID for every wheel index, shared by all threads
+static int32_t pay_by_index[NUM_BET_IDS][ARR_SIZE];
+
+//structure to hold the results of one thread, padded to its own cache lines
+typedef struct {
+    uint64_t seed; //seed of the run
+    uint64_t spins; //spins of the whole run
+    uint32_t index; //first block of the thread
+    uint32_t stride; //threads, blocks are dealt round robin
+    SpinKernel kernel; //kernel settling each block
+    SpinTotals totals[NUM_BET_TYPES]; //payout totals of each bet type
+} __attribute__((aligned(64))) SimThread;
+
+//run the blocks of one thread, block n always reads stream n of the seed so the totals
+//are the same for any thread count
+static void *simulate_thread(void *arg) {
+    SimThread *thread = arg;
+    uint32_t words[BLOCK_WORDS];
+    uint64_t blocks = (thread->spins + BLOCK_WORDS - 1) / BLOCK_WORDS;
+    for (uint64_t block = thread->index; block < blocks; block += thread->stride) {
+        uint64_t done = block * BLOCK_WORDS;
+        size_t count = (thread->spins - done < BLOCK_WORDS) ? (size_t)(thread->spins - done) : BLOCK_WORDS;
+        SimRng rng;
+        sim_rng_seed(&rng, thread->seed, block);
+        sim_rng_fill(&rng, words, count);
+        //settle every bet type, each block plays the next bet of the type
+        for (uint8_t t = 0; t < NUM_BET_TYPES; t++) {
+            uint8_t rows = bet_type_first_id[t + 1] - bet_type_first_id[t];
+            uint8_t bet_id = bet_type_first_id[t] + (block % rows);
+            thread->kernel(words, count, pay_by_index[bet_id], &thread->totals[t]);
+        }
+    }
+    return NULL;
+}
+
+//exact return per unit of a bet type on a fair wheel, averaged over its bets
+static double exact_return(uint8_t type) {
+    double total = 0;
+    uint8_t first = bet_type_first_id[type];
+    uint8_t last = bet_type_first_id[type + 1];
+    for (uint8_t id = first; id < last; id++) {
+        uint32_t paid = 0;
+        for (uint8_t p = 0; p < ARR_SIZE; p++) {
+            paid += payout_matrix[id][p];
+        }
+        total += ((double)paid / ARR_SIZE) - 1.0;
+    }
+    return total / (last - first);
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-n spins] [-t threads] [-s seed] [-k scalar|avx2|avx512]\n", name);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    uint64_t spins = 100000000;
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t threads = (cores > 0) ? (uint32_t)cores : 1;
+    uint64_t seed = 1;
+    SpinKernelKind kind = spin_kernel_best();
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:s:k:")) != -1) {
+        switch (opt) {
+            case 'n': spins = sim_parse_count(optarg); break;
+            case 't': threads = (uint32_t)atoi(optarg); break;
+            case 's': seed = strtoull(optarg, NULL, 0); break;
+            case 'k': kind = spin_kernel_parse(optarg); break;
+            default: usage(argv[0]);
+        }
+    }
+    if (spins == 0 || threads == 0 || kind == NUM_KERNELS) {
+        usage(argv[0]);
+    }
+    if (!spin_kernel_supported(kind)) {
+        fprintf(stderr, "simulate: %s is not supported here, using scalar\n", spin_kernel_names[kind]);
+        kind = KERNEL_SCALAR;
+    }
+    for (uint16_t id = 0; id < NUM_BET_IDS; id++) {
+        spin_kernel_prepare((uint8_t)id, pay_by_index[id]);
+    }
+
+    SimThread *work = aligned_alloc(64, threads * sizeof(SimThread));
+    if (work == NULL) {
+        fprintf(stderr, "simulate: out of memory\n");
+        return 1;
+    }
+    for (uint32_t i = 0; i < threads; i++) {
+        work[i].seed = seed;
+        work[i].spins = spins;
+        work[i].index = i;
+        work[i].stride = threads;
+        work[i].kernel = spin_kernel_get(kind);
+        for (uint8_t t = 0; t < NUM_BET_TYPES; t++) {
+            work[i].totals[t] = (SpinTotals) {0};
+        }
+    }
+    double start = sim_now();
+    if (sim_run_threads(threads, simulate_thread, work, sizeof(SimThread)) != 0) {
+        fprintf(stderr, "simulate: cannot start threads\n");
+        return 1;
+    }
+    double elapsed = sim_now() - start;
+
+    printf("%llu spins of the %s wheel on %u thread(s) in %.3f s (%.1f M spins/s, %s kernel, seed %llu)\n\n",
+           (unsigned long long)spins, WHEEL_NAME, threads, elapsed, spins / elapsed / 1e6, spin_kernel_names[kind],
+           (unsigned long long)seed);
+    printf("%-14s %10s %10s %10s %10s %10s %9s\n", "bet type", "return", "exact", "std err",
+           "variance", "hit rate", "z");
+    for (uint8_t t = 0; t < NUM_BET_TYPES; t++) {
+        uint64_t paid = 0;
+        uint64_t paid_sq = 0;
+        uint64_t wins = 0;
+        for (uint32_t i = 0; i < threads; i++) {
+            paid += work[i].totals[t].paid;
+            paid_sq += work[i].totals[t].paid_sq;
+            wins += work[i].totals[t].wins;
+        }
+        //net result of a one unit bet is payout - 1
+        double mean = ((double)paid / spins) - 1.0;
+        double variance = ((double)paid_sq / spins) - (((double)paid / spins) * ((double)paid / spins));
+        double std_err = sqrt(variance / spins);
+        double exact = exact_return(t);
+        printf("%-14s %+10.5f %+10.5f %10.5f %10.4f %10.5f %+9.2f\n", bet_type_names[t], mean, exact,
+               std_err, variance, (double)wins / spins, (mean - exact) / std_err);
+    }
+    free(work);
+    return 0;
+}
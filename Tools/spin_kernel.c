@@ -0,0 +1,144 @@
+//batched spin kernels for the host simulation path
+//
+//every kernel maps random words to wheel indexes with the same multiply-shift, gathers
+//the payout of one bet for that index and accumulates, so all of them give identical totals.
+//the vector kernels are compiled with target attributes and picked at run time.
+#include "spin_kernel.h"
+#include <immintrin.h>
+#include <string.h>
+
+#define LANE_FLUSH 4096 //words per block before 32-bit lane sums are widened
+
+const char *spin_kernel_names[NUM_KERNELS] = {"scalar", "avx2", "avx512"};
+
+//payout of a bet for every wheel index, the table the kernels gather from
+void spin_kernel_prepare(uint8_t bet_id, int32_t *pay_by_index) {
+    for (uint8_t i = 0; i < ARR_SIZE; i++) {
+        pay_by_index[i] = payout_matrix[bet_id][wheel_arr[i]];
+    }
+}
+
+static void kernel_scalar(const uint32_t *words, size_t count, const int32_t *pay_by_index, SpinTotals *totals) {
+    uint64_t paid = 0;
+    uint64_t paid_sq = 0;
+    uint64_t wins = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t payout = (uint32_t)pay_by_index[spin_index(words[i])];
+        paid += payout;
+        paid_sq += payout * payout;
+        wins += (payout != 0);
+    }
+    totals->spins += count;
+    totals->paid += paid;
+    totals->paid_sq += paid_sq;
+    totals->wins += wins;
+}
+
+__attribute__((target("avx2")))
+static uint64_t sum_lanes_avx2(__m256i v) {
+    uint32_t lanes[8];
+    uint64_t sum = 0;
+    _mm256_storeu_si256((__m256i *)lanes, v);
+    for (uint8_t i = 0; i < 8; i++) {
+        sum += lanes[i];
+    }
+    return sum;
+}
+
+__attribute__((target("avx2")))
+static void kernel_avx2(const uint32_t *words, size_t count, const int32_t *pay_by_index, SpinTotals *totals) {
+    const __m256i size = _mm256_set1_epi32(ARR_SIZE);
+    size_t i = 0;
+    while (count - i >= 8) {
+        size_t block_end = i + ((count - i < LANE_FLUSH) ? (count - i) & ~(size_t)7 : LANE_FLUSH);
+        __m256i paid = _mm256_setzero_si256();
+        __m256i paid_sq = _mm256_setzero_si256();
+        __m256i wins = _mm256_setzero_si256();
+        for (; i < block_end; i += 8) {
+            __m256i w = _mm256_loadu_si256((const __m256i *)(words + i));
+            //high half of word * ARR_SIZE, even lanes then odd lanes
+            __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(w, size), 32);
+            __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(w, 32), size);
+            __m256i index = _mm256_blend_epi32(even, odd, 0xAA);
+            __m256i payout = _mm256_i32gather_epi32(pay_by_index, index, 4);
+            paid = _mm256_add_epi32(paid, payout);
+            paid_sq = _mm256_add_epi32(paid_sq, _mm256_mullo_epi32(payout, payout));
+            wins = _mm256_sub_epi32(wins, _mm256_cmpgt_epi32(payout, _mm256_setzero_si256()));
+        }
+        totals->paid += sum_lanes_avx2(paid);
+        totals->paid_sq += sum_lanes_avx2(paid_sq);
+        totals->wins += sum_lanes_avx2(wins);
+    }
+    totals->spins += i;
+    kernel_scalar(words + i, count - i, pay_by_index, totals);
+}
+
+__attribute__((target("avx512f")))
+static void kernel_avx512(const uint32_t *words, size_t count, const int32_t *pay_by_index, SpinTotals *totals) {
+    const __m512i size = _mm512_set1_epi32(ARR_SIZE);
+    const __m512i one = _mm512_set1_epi32(1);
+    size_t i = 0;
+    while (count - i >= 16) {
+        size_t block_end = i + ((count - i < LANE_FLUSH) ? (count - i) & ~(size_t)15 : LANE_FLUSH);
+        __m512i paid = _mm512_setzero_si512();
+        __m512i paid_sq = _mm512_setzero_si512();
+        __m512i wins = _mm512_setzero_si512();
+        for (; i < block_end; i += 16) {
+            __m512i w = _mm512_loadu_si512((const void *)(words + i));
+            //high half of word * ARR_SIZE, even lanes then odd lanes
+            __m512i even = _mm512_srli_epi64(_mm512_mul_epu32(w, size), 32);
+            __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(w, 32), size);
+            __m512i index = _mm512_mask_blend_epi32(0xAAAA, even, odd);
+            __m512i payout = _mm512_i32gather_epi32(index, pay_by_index, 4);
+            paid = _mm512_add_epi32(paid, payout);
+            paid_sq = _mm512_add_epi32(paid_sq, _mm512_mullo_epi32(payout, payout));
+            __mmask16 hit = _mm512_cmpgt_epi32_mask(payout, _mm512_setzero_si512());
+            wins = _mm512_mask_add_epi32(wins, hit, wins, one);
+        }
+        totals->paid += (uint32_t)_mm512_reduce_add_epi32(paid);
+        totals->paid_sq += (uint32_t)_mm512_reduce_add_epi32(paid_sq);
+        totals->wins += (uint32_t)_mm512_reduce_add_epi32(wins);
+    }
+    totals->spins += i;
+    kernel_scalar(words + i, count - i, pay_by_index, totals);
+}
+
+//check if the running CPU can execute a kernel
+bool spin_kernel_supported(SpinKernelKind kind) {
+    __builtin_cpu_init();
+    switch (kind) {
+        case KERNEL_SCALAR: return true;
+        case KERNEL_AVX2: return __builtin_cpu_supports("avx2");
+        case KERNEL_AVX512: return __builtin_cpu_supports("avx512f");
+        default: return false;
+    }
+}
+
+//get a kernel, falls back to scalar if the CPU lacks the instructions
+SpinKernel spin_kernel_get(SpinKernelKind kind) {
+    if (!spin_kernel_supported(kind)) {
+        kind = KERNEL_SCALAR;
+    }
+    switch (kind) {
+        case KERNEL_AVX2: return kernel_avx2;
+        case KERNEL_AVX512: return kernel_avx512;
+        default: return kernel_scalar;
+    }
+}
+
+//widest kernel the running CPU supports
+SpinKernelKind spin_kernel_best(void) {
+    if (spin_kernel_supported(KERNEL_AVX512)) return KERNEL_AVX512;
+    if (spin_kernel_supported(KERNEL_AVX2)) return KERNEL_AVX2;
+    return KERNEL_SCALAR;
+}
+
+//kernel from its name, NUM_KERNELS if unknown
+SpinKernelKind spin_kernel_parse(const char *name) {
+    for (uint8_t k = 0; k < NUM_KERNELS; k++) {
+        if (strcmp(name, spin_kernel_names[k]) == 0) {
+            return (SpinKernelKind)k;
+        }
+    }
+    return NUM_KERNELS;
+}
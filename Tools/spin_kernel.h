@@ -0,0 +1,33 @@
+#ifndef TOOLS_SPIN_KERNEL_H_
+#define TOOLS_SPIN_KERNEL_H_
+#include "sim.h"
+#include <stdbool.h>
+
+//instruction sets a kernel can be built for
+typedef enum {
+    KERNEL_SCALAR,
+    KERNEL_AVX2,
+    KERNEL_AVX512,
+    NUM_KERNELS
+} SpinKernelKind;
+
+//totals of a one unit bet over a block of spins
+typedef struct {
+    uint64_t spins; //spins settled
+    uint64_t paid; //sum of payouts (stake included)
+    uint64_t paid_sq; //sum of squared payouts
+    uint64_t wins; //spins where the bet paid
+} SpinTotals;
+
+//settle one bet for every random word of a block, pay_by_index comes from spin_kernel_prepare
+typedef void (*SpinKernel)(const uint32_t *, size_t, const int32_t *, SpinTotals *);
+
+extern const char *spin_kernel_names[NUM_KERNELS];
+
+void spin_kernel_prepare(uint8_t, int32_t *);
+bool spin_kernel_supported(SpinKernelKind);
+SpinKernel spin_kernel_get(SpinKernelKind);
+SpinKernelKind spin_kernel_best(void);
+SpinKernelKind spin_kernel_parse(const char *);
+
+#endif
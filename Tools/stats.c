@@ -0,0 +1,212 @@
+//streaming statistics for the host simulation tools
+//
+//every accumulator has fixed size and merges into another of the same kind, so each thread
+//or shard keeps its own and they are combined without locks once the work is done.
+//histograms and sketches hold integer counts and merge exactly in any order, running stats
+//merge in floating point, so merge them in a fixed order for repeatable output.
+#include "stats.h"
+#include <math.h>
+#include <string.h>
+
+//start empty
+void stats_init(RunningStats *stats) {
+    *stats = (RunningStats) {0, 0, 0, INFINITY, -INFINITY, 0, 0};
+}
+
+//add one value
+void stats_add(RunningStats *stats, double value) {
+    stats->count++;
+    double delta = value - stats->mean;
+    stats->mean += delta / stats->count;
+    stats->m2 += delta * (value - stats->mean);
+    stats->at_min = (value < stats->min) ? 1 : stats->at_min + (value == stats->min);
+    stats->at_max = (value > stats->max) ? 1 : stats->at_max + (value == stats->max);
+    stats->min = (value < stats->min) ? value : stats->min;
+    stats->max = (value > stats->max) ? value : stats->max;
+}
+
+//fold src into dst (Chan et al. pairwise update)
+void stats_merge(RunningStats *dst, const RunningStats *src) {
+    if (src->count == 0) {
+        return;
+    }
+    if (dst->count == 0) {
+        *dst = *src;
+        return;
+    }
+    double count = (double)dst->count + (double)src->count;
+    double delta = src->mean - dst->mean;
+    dst->mean += delta * (src->count / count);
+    dst->m2 += src->m2 + (delta * delta * ((double)dst->count * src->count / count));
+    dst->count += src->count;
+    dst->at_min = (src->min < dst->min) ? src->at_min : dst->at_min + ((src->min == dst->min) ? src->at_min : 0);
+    dst->at_max = (src->max > dst->max) ? src->at_max : dst->at_max + ((src->max == dst->max) ? src->at_max : 0);
+    dst->min = (src->min < dst->min) ? src->min : dst->min;
+    dst->max = (src->max > dst->max) ? src->max : dst->max;
+}
+
+//sample variance, 0 under two values
+double stats_variance(const RunningStats *stats) {
+    return (stats->count > 1) ? stats->m2 / (stats->count - 1) : 0;
+}
+
+//start empty with buckets [lo + i * width, lo + (i + 1) * width)
+void histogram_init(Histogram *histogram, double lo, double width) {
+    memset(histogram, 0, sizeof(Histogram));
+    histogram->lo = lo;
+    histogram->width = width;
+}
+
+//add one value
+void histogram_add(Histogram *histogram, double value) {
+    double bucket = floor((value - histogram->lo) / histogram->width);
+    if (bucket < 0) {
+        histogram->below++;
+    } else if (bucket >= HISTOGRAM_BUCKETS) {
+        histogram->above++;
+    } else {
+        histogram->counts[(uint32_t)bucket]++;
+    }
+}
+
+//fold src into dst, both need the same lo and width
+void histogram_merge(Histogram *dst, const Histogram *src) {
+    dst->below += src->below;
+    dst->above += src->above;
+    for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        dst->counts[i] += src->counts[i];
+    }
+}
+
+//lower edge of a bucket
+double histogram_edge(const Histogram *histogram, uint32_t bucket) {
+    return histogram->lo + (bucket * histogram->width);
+}
+
+//start empty
+void sketch_init(QuantileSketch *sketch) {
+    memset(sketch, 0, sizeof(QuantileSketch));
+}
+
+//log bucket of a magnitude of at least 1, the last bucket takes everything bigger
+static uint32_t sketch_bucket(double magnitude) {
+    double bucket = ceil(log(magnitude) / log(SKETCH_GAMMA));
+    return (bucket < SKETCH_BUCKETS - 1) ? (uint32_t)bucket : SKETCH_BUCKETS - 1;
+}
+
+//middle of a log bucket, within 1% of every value in it
+static double sketch_value(uint32_t bucket) {
+    return 2 * pow(SKETCH_GAMMA, bucket) / (SKETCH_GAMMA + 1);
+}
+
+//add one value
+void sketch_add(QuantileSketch *sketch, double value) {
+    sketch->count++;
+    if (value >= 1) {
+        sketch->positive[sketch_bucket(value)]++;
+    } else if (value <= -1) {
+        sketch->negative[sketch_bucket(-value)]++;
+    } else {
+        sketch->zero++;
+    }
+}
+
+//fold src into dst
+void sketch_merge(QuantileSketch *dst, const QuantileSketch *src) {
+    dst->count += src->count;
+    dst->zero += src->zero;
+    for (uint32_t i = 0; i < SKETCH_BUCKETS; i++) {
+        dst->positive[i] += src->positive[i];
+        dst->negative[i] += src->negative[i];
+    }
+}
+
+//middle of the log bucket holding a fraction 0..1 of the sorted values
+static double sketch_bucket_quantile(const QuantileSketch *sketch, double fraction) {
+    uint64_t rank = (uint64_t)(fraction * (sketch->count - 1));
+    uint64_t seen = 0;
+    //negative values from the most negative up, then zero, then positive values
+    for (uint32_t i = SKETCH_BUCKETS; i-- > 0;) {
+        seen += sketch->negative[i];
+        if (seen > rank) {
+            return -sketch_value(i);
+        }
+    }
+    seen += sketch->zero;
+    if (seen > rank) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < SKETCH_BUCKETS; i++) {
+        seen += sketch->positive[i];
+        if (seen > rank) {
+            return sketch_value(i);
+        }
+    }
+    return sketch_value(SKETCH_BUCKETS - 1);
+}
+
+//value at a fraction 0..1 of the sorted values, 0 if the sketch is empty. the running stats
+//of the same values make it exact where it falls on a run of values equal to their min or max,
+//like sessions that all hit the spin limit, and keep a bucket middle within the two
+double sketch_quantile(const QuantileSketch *sketch, const RunningStats *stats, double fraction) {
+    if (sketch->count == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(fraction * (sketch->count - 1));
+    if (rank < stats->at_min) {
+        return stats->min;
+    }
+    if (rank >= stats->count - stats->at_max) {
+        return stats->max;
+    }
+    double value = sketch_bucket_quantile(sketch, fraction);
+    value = (value < stats->min) ? stats->min : value;
+    return (value > stats->max) ? stats->max : value;
+}
+
+//regularized upper incomplete gamma Q(a, x), series below a + 1, continued fraction above
+static double gamma_q(double a, double x) {
+    if (x <= 0) {
+        return 1;
+    }
+    double log_front = (a * log(x)) - x - lgamma(a);
+    if (x < a + 1) {
+        double term = 1 / a;
+        double sum = term;
+        for (uint32_t n = 1; n < 100000 && term > sum * 1e-16; n++) {
+            term *= x / (a + n);
+            sum += term;
+        }
+        return 1 - (sum * exp(log_front));
+    }
+    //modified Lentz evaluation of the continued fraction
+    double b = x + 1 - a;
+    double c = 1 / 1e-300;
+    double d = 1 / b;
+    double h = d;
+    for (uint32_t n = 1; n < 100000; n++) {
+        double an = -(double)n * (n - a);
+        b += 2;
+        d = (an * d) + b;
+        d = (fabs(d) < 1e-300) ? 1e-300 : d;
+        c = b + (an / c);
+        c = (fabs(c) < 1e-300) ? 1e-300 : c;
+        d = 1 / d;
+        double step = d * c;
+        h *= step;
+        if (fabs(step - 1) < 1e-16) {
+            break;
+        }
+    }
+    return exp(log_front) * h;
+}
+
+//probability of a chi-square value at least this large with df degrees of freedom
+double chi_square_p(double chi2, double df) {
+    return gamma_q(df / 2, chi2 / 2);
+}
+
+//two sided probability of a standard normal value at least this far from 0
+double normal_p(double z) {
+    return erfc(fabs(z) / sqrt(2));
+}
@@ -0,0 +1,55 @@
+#ifndef TOOLS_STATS_H_
+#define TOOLS_STATS_H_
+#include <stdint.h>
+
+#define HISTOGRAM_BUCKETS 64 //fixed buckets of a histogram, plus one below and one above
+#define SKETCH_BUCKETS 1024 //log buckets per sign of a quantile sketch
+#define SKETCH_GAMMA 1.02 //bucket growth, quantiles are within 1% of the true value
+
+//running count, mean, variance, min and max (Welford)
+typedef struct {
+    uint64_t count; //values added
+    double mean; //running mean
+    double m2; //sum of squared distances from the mean
+    double min; //smallest value
+    double max; //largest value
+    uint64_t at_min; //values equal to min
+    uint64_t at_max; //values equal to max
+} RunningStats;
+
+//fixed bucket histogram
+typedef struct {
+    double lo; //lower edge of the first bucket
+    double width; //width of every bucket
+    uint64_t below; //values under lo
+    uint64_t above; //values at or over the last edge
+    uint64_t counts[HISTOGRAM_BUCKETS]; //values per bucket
+} Histogram;
+
+//quantile sketch with log sized buckets, fixed memory for any number of values
+typedef struct {
+    uint64_t count; //values added
+    uint64_t zero; //values with magnitude under 1
+    uint64_t positive[SKETCH_BUCKETS]; //positive values per log bucket
+    uint64_t negative[SKETCH_BUCKETS]; //negative values per log bucket
+} QuantileSketch;
+
+void stats_init(RunningStats *);
+void stats_add(RunningStats *, double);
+void stats_merge(RunningStats *, const RunningStats *);
+double stats_variance(const RunningStats *);
+
+void histogram_init(Histogram *, double, double);
+void histogram_add(Histogram *, double);
+void histogram_merge(Histogram *, const Histogram *);
+double histogram_edge(const Histogram *, uint32_t);
+
+void sketch_init(QuantileSketch *);
+void sketch_add(QuantileSketch *, double);
+void sketch_merge(QuantileSketch *, const QuantileSketch *);
+double sketch_quantile(const QuantileSketch *, const RunningStats *, double);
+
+double chi_square_p(double, double);
+double normal_p(double);
+
+#endif
@@ -0,0 +1,136 @@
+//betting progressions for the host strategy simulator
+//
+//each progression is a small state object: strategy_next() picks the stake and bet from
+//the state, strategy_settle() moves the state on from the outcome of that bet.
+#include "strategy.h"
+#include <string.h>
+
+#define FIB_STEPS 40 //Fibonacci numbers that fit in 32 bits (and far beyond any table max)
+
+const char *strategy_names[NUM_STRATEGIES] = {
+    "Flat", "Martingale", "Fibonacci", "D'Alembert", "Labouchere", "Paroli"
+};
+
+//starting Labouchere line, 1-2-3-4 wins ten units
+static const uint32_t labouchere_start[] = {1, 2, 3, 4};
+
+//Fibonacci number of a step, saturating instead of overflowing
+static uint32_t fibonacci(uint8_t step) {
+    uint32_t a = 1;
+    uint32_t b = 1;
+    for (uint8_t i = 0; i < step && i < FIB_STEPS; i++) {
+        uint32_t next = a + b;
+        a = b;
+        b = (next < b) ? UINT32_MAX : next;
+    }
+    return a;
+}
+
+//restart the Labouchere line
+static void labouchere_restart(Strategy *strategy) {
+    uint8_t count = sizeof(labouchere_start) / sizeof(labouchere_start[0]);
+    memcpy(strategy->line, labouchere_start, sizeof(labouchere_start));
+    strategy->line_head = 0;
+    strategy->line_tail = count;
+}
+
+//put a progression back at its first bet
+void strategy_reset(Strategy *strategy, StrategyKind kind) {
+    strategy->kind = kind;
+    strategy->units = 1;
+    strategy->fib_index = 0;
+    strategy->streak = 0;
+    labouchere_restart(strategy);
+}
+
+//pick the next stake and bet, clamped to the table limits and the bankroll
+StrategyBet strategy_next(const Strategy *strategy, const TableRules *rules, uint32_t bankroll) {
+    uint64_t units = strategy->units;
+    if (strategy->kind == STRATEGY_FIBONACCI) {
+        units = fibonacci(strategy->fib_index);
+    } else if (strategy->kind == STRATEGY_LABOUCHERE) {
+        units = strategy->line[strategy->line_head];
+        if (strategy->line_tail - strategy->line_head > 1) {
+            units += strategy->line[strategy->line_tail - 1];
+        }
+    }
+    uint64_t stake = units * rules->unit;
+    if (stake < rules->table_min) stake = rules->table_min;
+    if (stake > rules->table_max) stake = rules->table_max;
+    if (stake > bankroll) stake = bankroll; //all in, the caller stops below the minimum
+    return (StrategyBet) {(uint32_t)stake, rules->bet_id};
+}
+
+//move the progression on from the outcome of its last bet
+void strategy_settle(Strategy *strategy, bool won) {
+    switch (strategy->kind) {
+        case STRATEGY_FLAT:
+            break;
+        case STRATEGY_MARTINGALE: //double after a loss, back to one unit after a win
+            strategy->units = won ? 1 : ((strategy->units > UINT32_MAX / 2) ? UINT32_MAX : strategy->units * 2);
+            break;
+        case STRATEGY_FIBONACCI: //one step up after a loss, two steps back after a win
+            if (won) {
+                strategy->fib_index = (strategy->fib_index > 2) ? strategy->fib_index - 2 : 0;
+            } else if (strategy->fib_index < FIB_STEPS) {
+                strategy->fib_index++;
+            }
+            break;
+        case STRATEGY_DALEMBERT: //one unit up after a loss, one unit down after a win
+            if (won) {
+                strategy->units = (strategy->units > 1) ? strategy->units - 1 : 1;
+            } else if (strategy->units < UINT32_MAX) {
+                strategy->units++;
+            }
+            break;
+        case STRATEGY_LABOUCHERE: //cross off both ends after a win, append the stake after a loss
+            if (won) {
+                strategy->line_head++;
+                if (strategy->line_tail > strategy->line_head) {
+                    strategy->line_tail--;
+                }
+                if (strategy->line_head >= strategy->line_tail) {
+                    labouchere_restart(strategy); //line won, start a new one
+                }
+            } else {
+                uint32_t lost = strategy->line[strategy->line_head];
+                if (strategy->line_tail - strategy->line_head > 1) {
+                    lost += strategy->line[strategy->line_tail - 1];
+                }
+                if (strategy->line_tail == LABOUCHERE_LINE) {
+                    //slide the live entries to the front to make room
+                    uint8_t count = strategy->line_tail - strategy->line_head;
+                    memmove(strategy->line, strategy->line + strategy->line_head, count * sizeof(uint32_t));
+                    strategy->line_head = 0;
+                    strategy->line_tail = count;
+                }
+                if (strategy->line_tail == LABOUCHERE_LINE) {
+                    labouchere_restart(strategy); //line too long, give it up
+                } else {
+                    strategy->line[strategy->line_tail++] = lost;
+                }
+            }
+            break;
+        case STRATEGY_PAROLI: //let wins ride up to the streak, back to one unit after a loss
+            if (won && strategy->streak + 1 < PAROLI_STREAK) {
+                strategy->streak++;
+                strategy->units *= 2;
+            } else {
+                strategy->streak = 0;
+                strategy->units = 1;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+//progression from its name, NUM_STRATEGIES if unknown
+StrategyKind strategy_parse(const char *name) {
+    for (uint8_t k = 0; k < NUM_STRATEGIES; k++) {
+        if (strcmp(name, strategy_names[k]) == 0) {
+            return (StrategyKind)k;
+        }
+    }
+    return NUM_STRATEGIES;
+}
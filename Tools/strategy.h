@@ -0,0 +1,52 @@
+#ifndef TOOLS_STRATEGY_H_
+#define TOOLS_STRATEGY_H_
+#include "payouts.h"
+#include <stdbool.h>
+
+#define LABOUCHERE_LINE 32 //longest Labouchere line before it is restarted
+#define PAROLI_STREAK 3 //wins Paroli lets ride before going back to one unit
+
+//betting progressions
+typedef enum {
+    STRATEGY_FLAT,
+    STRATEGY_MARTINGALE,
+    STRATEGY_FIBONACCI,
+    STRATEGY_DALEMBERT,
+    STRATEGY_LABOUCHERE,
+    STRATEGY_PAROLI,
+    NUM_STRATEGIES
+} StrategyKind;
+
+//table rules every progression must respect
+typedef struct {
+    uint32_t table_min; //smallest stake accepted
+    uint32_t table_max; //largest stake accepted
+    uint32_t unit; //base stake of the progressions
+    uint8_t bet_id; //bet played on every spin
+} TableRules;
+
+//state of one progression during a session
+typedef struct {
+    StrategyKind kind; //progression being played
+    uint32_t units; //stake in units for Flat/Martingale/D'Alembert/Paroli
+    uint8_t fib_index; //Fibonacci position
+    uint8_t streak; //Paroli wins in a row
+    uint8_t line_head; //first live entry of the Labouchere line
+    uint8_t line_tail; //one past the last live entry
+    uint32_t line[LABOUCHERE_LINE]; //Labouchere line in units
+} Strategy;
+
+//what the progression wants to play next
+typedef struct {
+    uint32_t stake; //money staked, already inside the table limits
+    uint8_t bet_id; //bet to place
+} StrategyBet;
+
+extern const char *strategy_names[NUM_STRATEGIES];
+
+void strategy_reset(Strategy *, StrategyKind);
+StrategyBet strategy_next(const Strategy *, const TableRules *, uint32_t);
+void strategy_settle(Strategy *, bool);
+StrategyKind strategy_parse(const char *);
+
+#endif
@@ -0,0 +1,260 @@
+//betting progression simulator, runs on the build host
+//
+//plays whole sessions of each progression in strategy.c against the generated payout
+//matrix: a session starts from the bankroll of starting_chips and ends when the player
+//can no longer cover the table minimum (bust), reaches the goal, or hits the spin limit.
+//reports bust rate, median session length and the final bankroll distribution, the same
+//for any thread count.
+//
+//build and run (from the repository root):
+//  gcc -O2 -pthread -ICore/Src -ITools Tools/strategy_sim.c Tools/strategy.c Tools/stats.c Tools/sim.c Core/Src/chips.c Core/Src/bets.c Core/Src/spots.c Core/Src/payouts_*.c -lm -o strategy_sim
+//  ./strategy_sim -n 1e6 -b Red -m 5 -M 500 -g 3000
+#include "bets.h"
+#include "chips.h"
+#include "sim.h"
+#include "stats.h"
+#include "strategy.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+
+#define SHARD_SESSIONS 1024 //sessions per shard, each shard has its own random streams
+#define PRINT_BUCKETS 16 //rows shown by -H
+
+//settings shared by every session
+typedef struct {
+    TableRules rules; //limits and bet
+    uint32_t bankroll; //starting bankroll
+    uint32_t goal; //bankroll that ends a session as a win
+    uint32_t max_spins; //spins that end a session
+    uint64_t sessions; //sessions per progression
+    uint64_t seed; //seed of the run
+    double net_lo; //lowest net result, edge of the net histogram
+    double net_width; //net result per histogram bucket
+} SessionConfig;
+
+//results of one progression, accumulated over sessions
+typedef struct {
+    uint64_t busts; //sessions that ended below the table minimum
+    uint64_t goals; //sessions that reached the goal
+    RunningStats final; //final bankroll
+    RunningStats length; //spins per session
+    QuantileSketch final_sketch; //final bankroll percentiles
+    QuantileSketch length_sketch; //session length percentiles
+    Histogram net; //final bankroll minus starting bankroll
+} StrategyResults;
+
+//results of one shard, or of the whole run
+typedef struct {
+    StrategyResults results[NUM_STRATEGIES]; //results per progression
+} ShardResults;
+
+static bool selected[NUM_STRATEGIES]; //progressions being simulated
+
+//play one session and return the final bankroll
+static uint64_t play_session(StrategyKind kind, const SessionConfig *config, SimRng *rng, uint32_t *spins) {
+    Strategy strategy;
+    uint64_t bankroll = config->bankroll;
+    uint32_t spin = 0;
+    strategy_reset(&strategy, kind);
+    while (spin < config->max_spins && bankroll >= config->rules.table_min && bankroll < config->goal) {
+        StrategyBet bet = strategy_next(&strategy, &config->rules, (uint32_t)bankroll);
+        uint8_t payout = payout_matrix[bet.bet_id][sim_spin(rng)];
+        bankroll = bankroll - bet.stake + ((uint64_t)bet.stake * payout);
+        strategy_settle(&strategy, payout != 0);
+        spin++;
+    }
+    *spins = spin;
+    return bankroll;
+}
+
+//empty results for every progression
+static void results_init(ShardResults *shard, const SessionConfig *config) {
+    for (uint8_t k = 0; k < NUM_STRATEGIES; k++) {
+        StrategyResults *results = &shard->results[k];
+        results->busts = 0;
+        results->goals = 0;
+        stats_init(&results->final);
+        stats_init(&results->length);
+        sketch_init(&results->final_sketch);
+        sketch_init(&results->length_sketch);
+        histogram_init(&results->net, config->net_lo, config->net_width);
+    }
+}
+
+//play the sessions of one shard, its random streams depend only on the shard number
+static void run_shard(void *ctx, uint64_t shard, void *slot) {
+    const SessionConfig *config = ctx;
+    ShardResults *out = slot;
+    uint64_t first = shard * SHARD_SESSIONS;
+    uint64_t count = (config->sessions - first < SHARD_SESSIONS) ? config->sessions - first : SHARD_SESSIONS;
+    results_init(out, config);
+    for (uint8_t k = 0; k < NUM_STRATEGIES; k++) {
+        if (!selected[k]) {
+            continue;
+        }
+        StrategyResults *results = &out->results[k];
+        SimRng rng;
+        sim_rng_seed(&rng, config->seed, (shard * NUM_STRATEGIES) + k);
+        for (uint64_t i = 0; i < count; i++) {
+            uint32_t spins;
+            uint64_t final = play_session((StrategyKind)k, config, &rng, &spins);
+            results->busts += (final < config->rules.table_min);
+            results->goals += (final >= config->goal);
+            stats_add(&results->final, (double)final);
+            stats_add(&results->length, spins);
+            sketch_add(&results->final_sketch, (double)final);
+            sketch_add(&results->length_sketch, spins);
+            histogram_add(&results->net, (double)final - config->bankroll);
+        }
+    }
+}
+
+static ShardResults total; //results of the whole run, merged in shard order
+
+//fold a finished shard into the run results
+static void merge_shard(void *ctx, uint64_t shard, void *slot) {
+    (void)ctx;
+    (void)shard;
+    const ShardResults *in = slot;
+    for (uint8_t k = 0; k < NUM_STRATEGIES; k++) {
+        StrategyResults *results = &total.results[k];
+        results->busts += in->results[k].busts;
+        results->goals += in->results[k].goals;
+        stats_merge(&results->final, &in->results[k].final);
+        stats_merge(&results->length, &in->results[k].length);
+        sketch_merge(&results->final_sketch, &in->results[k].final_sketch);
+        sketch_merge(&results->length_sketch, &in->results[k].length_sketch);
+        histogram_merge(&results->net, &in->results[k].net);
+    }
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "usage: %s [-n sessions] [-t threads] [-s seed] [-b bet type] [-m table min]\n"
+                    "       [-M table max] [-u unit] [-B bankroll] [-g goal] [-l max spins]\n"
+                    "       [-S strategy] [-H]\n", name);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t threads = (cores > 0) ? (uint32_t)cores : 1;
+    bool show_histogram = false;
+    bool any_selected = false;
+    BetType bet_type = BET_RED;
+    SessionConfig config = {
+        .rules = {.table_min = 5, .table_max = 500, .unit = 0},
+        .bankroll = calculate_total_balance(starting_chips),
+        .goal = 0,
+        .max_spins = 1000,
+        .sessions = 1000000,
+        .seed = 1
+    };
+    int opt;
+    while ((opt = getopt(argc, argv, "n:t:s:b:m:M:u:B:g:l:S:H")) != -1) {
+        switch (opt) {
+            case 'n': config.sessions = sim_parse_count(optarg); break;
+            case 't': threads = (uint32_t)atoi(optarg); break;
+            case 's': config.seed = strtoull(optarg, NULL, 0); break;
+            case 'b': bet_type = parse_bet_type(optarg); break;
+            case 'm': config.rules.table_min = (uint32_t)atoi(optarg); break;
+            case 'M': config.rules.table_max = (uint32_t)atoi(optarg); break;
+            case 'u': config.rules.unit = (uint32_t)atoi(optarg); break;
+            case 'B': config.bankroll = (uint32_t)atoi(optarg); break;
+            case 'g': config.goal = (uint32_t)atoi(optarg); break;
+            case 'l': config.max_spins = (uint32_t)atoi(optarg); break;
+            case 'S': {
+                StrategyKind kind = strategy_parse(optarg);
+                if (kind == NUM_STRATEGIES) {
+                    usage(argv[0]);
+                }
+                selected[kind] = true;
+                any_selected = true;
+                break;
+            }
+            case 'H': show_histogram = true; break;
+            default: usage(argv[0]);
+        }
+    }
+    if (config.rules.unit == 0) {
+        config.rules.unit = config.rules.table_min;
+    }
+    if (config.goal == 0) {
+        config.goal = config.bankroll + (config.bankroll / 2); //play for +50%
+    }
+    if (config.sessions == 0 || threads == 0 || bet_type == BET_TYPE_NONE || config.rules.table_min == 0 ||
+        config.rules.table_max < config.rules.table_min || config.goal <= config.bankroll) {
+        usage(argv[0]);
+    }
+    //every bet of a multi-row type behaves the same, play its first one
+    config.rules.bet_id = bet_type_first_id[bet_type];
+    //net results run from losing the bankroll to the goal plus one maximum win
+    uint8_t max_payout = 0;
+    for (uint8_t p = 0; p < ARR_SIZE; p++) {
+        max_payout = (payout_matrix[config.rules.bet_id][p] > max_payout) ? payout_matrix[config.rules.bet_id][p] : max_payout;
+    }
+    double net_max = (double)config.goal - config.bankroll + ((double)config.rules.table_max * max_payout);
+    config.net_lo = -(double)config.bankroll;
+    config.net_width = ceil((net_max - config.net_lo) / HISTOGRAM_BUCKETS);
+    for (uint8_t k = 0; k < NUM_STRATEGIES; k++) {
+        selected[k] |= !any_selected;
+    }
+
+    //fixed shards merged in shard order give the same output for any thread count
+    results_init(&total, &config);
+    uint64_t shards = (config.sessions + SHARD_SESSIONS - 1) / SHARD_SESSIONS;
+    double start = sim_now();
+    if (sim_run_shards(threads, shards, run_shard, merge_shard, &config, sizeof(ShardResults)) != 0) {
+        fprintf(stderr, "strategy_sim: cannot start threads\n");
+        return 1;
+    }
+    double elapsed = sim_now() - start;
+
+    uint64_t played = 0;
+    double spun = 0;
+    for (uint8_t k = 0; k < NUM_STRATEGIES; k++) {
+        played += total.results[k].length.count;
+        spun += total.results[k].length.mean * total.results[k].length.count;
+    }
+    printf("%llu sessions per strategy on %u thread(s) in %.2f s (%.2f M sessions/min, %.1f M spins/s)\n",
+           (unsigned long long)config.sessions, threads, elapsed, 60.0 * played / elapsed / 1e6, spun / elapsed / 1e6);
+    printf("%s bet on the %s wheel, table $%u-$%u, unit $%u, bankroll $%u, goal $%u, at most %u spins per session, seed %llu\n\n",
+           bet_type_names[bet_type], WHEEL_NAME, config.rules.table_min, config.rules.table_max, config.rules.unit,
+           config.bankroll, config.goal, config.max_spins, (unsigned long long)config.seed);
+    printf("%-11s %8s %8s %8s %10s %10s %9s %9s %9s %9s %9s\n", "strategy", "bust", "goal", "median",
+           "mean $", "std dev $", "P1 $", "P10 $", "P50 $", "P90 $", "P99 $");
+    for (uint8_t k = 0; k < NUM_STRATEGIES; k++) {
+        if (!selected[k]) {
+            continue;
+        }
+        const StrategyResults *results = &total.results[k];
+        uint64_t count = results->final.count;
+        printf("%-11s %7.3f%% %7.3f%% %8.0f %10.2f %10.2f", strategy_names[k], 100.0 * results->busts / count,
+               100.0 * results->goals / count, sketch_quantile(&results->length_sketch, &results->length, 0.5),
+               results->final.mean, sqrt(stats_variance(&results->final)));
+        //final bankroll percentiles, within 1% from the sketch
+        static const double fractions[] = {0.01, 0.10, 0.50, 0.90, 0.99};
+        for (uint8_t f = 0; f < sizeof(fractions) / sizeof(fractions[0]); f++) {
+            printf(" %9.0f", sketch_quantile(&results->final_sketch, &results->final, fractions[f]));
+        }
+        putchar('\n');
+        if (show_histogram) {
+            //net result histogram, buckets merged down to PRINT_BUCKETS rows
+            uint32_t per_row = HISTOGRAM_BUCKETS / PRINT_BUCKETS;
+            for (uint32_t row = 0; row < PRINT_BUCKETS; row++) {
+                uint64_t rows = 0;
+                for (uint32_t b = row * per_row; b < (row + 1) * per_row; b++) {
+                    rows += results->net.counts[b];
+                }
+                printf("    %+9.0f $ %7.3f%% ", histogram_edge(&results->net, row * per_row), 100.0 * rows / count);
+                for (uint32_t bar = 0; bar < (uint32_t)(50.0 * rows / count); bar++) {
+                    putchar('#');
+                }
+                putchar('\n');
+            }
+        }
+    }
+    return 0;
+}
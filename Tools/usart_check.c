@@ -0,0 +1,189 @@
+//byte exact check of the USART2 transmit ring and its DMA, runs on the build host
+//
+//builds usart.c against the register stand-in in Tools/hal and plays the DMA: at every point
+//the firmware lets interrupts in, channel 7 moves a random number of bytes from memory to the
+//wire, raises its half and complete flags and, if interrupts are on, runs the interrupt.
+//random writes of up to twice the ring, some from "interrupt context" with interrupts off so
+//the writer must drain the DMA itself, must come out of the wire exactly as written, and the
+//terminal screens must come out the same at any DMA speed.
+//
+//build and run (from the repository root):
+//  gcc -O2 -ITools/hal -ICore/Src Tools/usart_check.c Core/Src/usart.c Core/Src/screen.c Core/Src/start_screen_*.c Core/Src/format.c Core/Src/spots.c Core/Src/chips.c Core/Src/payouts_*.c -o usart_check
+//  ./usart_check -s 1
+#include "usart.h"
+#include "payouts.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WRITES 20000 //random writes checked
+#define WIRE_SIZE (1u << 26) //bytes the wire can hold
+
+void DMA1_Channel7_IRQHandler(void);
+
+static GPIO_TypeDef gpioa;
+static USART_TypeDef usart2;
+static RCC_TypeDef rcc;
+static NVIC_Type nvic;
+static DMA_TypeDef dma1;
+static DMA_Channel_TypeDef dma1_channel7;
+static DMA_Request_TypeDef dma1_cselr;
+GPIO_TypeDef *GPIOA = &gpioa;
+USART_TypeDef *USART2 = &usart2;
+RCC_TypeDef *RCC = &rcc;
+NVIC_Type *NVIC = &nvic;
+DMA_TypeDef *DMA1 = &dma1;
+DMA_Channel_TypeDef *DMA1_Channel7 = &dma1_channel7;
+DMA_Request_TypeDef *DMA1_CSELR = &dma1_cselr;
+uint32_t host_primask = 1; //interrupts stay off until the check turns them on
+
+static char *wire; //bytes the USART sent
+static size_t wire_length = 0;
+static uint32_t dma_budget = 0; //most bytes the DMA moves between two interrupt points, 0 for all
+static uint32_t dma_total = 0; //bytes of the transfer in flight, 0 when idle
+static bool in_interrupt = false;
+static uint64_t rng_state;
+
+//xorshift64, only picks lengths and timings
+static uint32_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 32);
+}
+
+//the hardware between two instructions: clear acknowledged flags, move bytes, raise flags,
+//then take the interrupt if it is enabled and interrupts are on
+void host_interrupt_point(void) {
+    uint32_t clear = dma1.IFCR;
+    dma1.IFCR = 0;
+    dma1.ISR &= ~((clear & DMA_IFCR_CGIF7) ? (DMA_ISR_GIF7 | DMA_ISR_TCIF7 | DMA_ISR_HTIF7 | DMA_ISR_TEIF7) : clear);
+    if (dma_total == 0 && (dma1_channel7.CCR & DMA_CCR_EN) && dma1_channel7.CNDTR > 0) {
+        dma_total = dma1_channel7.CNDTR;
+    }
+    if (dma_total != 0 && (usart2.CR3 & USART_CR3_DMAT) && (dma1_channel7.CCR & DMA_CCR_EN)) {
+        uint32_t count = (dma_budget == 0) ? dma1_channel7.CNDTR : next_random() % (dma_budget + 1);
+        count = (count < dma1_channel7.CNDTR) ? count : dma1_channel7.CNDTR;
+        const char *memory = (const char *)dma1_channel7.CMAR + (dma_total - dma1_channel7.CNDTR);
+        if (wire_length + count > WIRE_SIZE) {
+            fprintf(stderr, "usart_check: wire overflow\n");
+            exit(2);
+        }
+        memcpy(wire + wire_length, memory, count);
+        wire_length += count;
+        uint32_t before = dma1_channel7.CNDTR;
+        dma1_channel7.CNDTR -= count;
+        if (before > dma_total / 2 && dma1_channel7.CNDTR <= dma_total / 2) {
+            dma1.ISR |= DMA_ISR_GIF7 | DMA_ISR_HTIF7;
+        }
+        if (dma1_channel7.CNDTR == 0) {
+            dma1.ISR |= DMA_ISR_GIF7 | DMA_ISR_TCIF7;
+            dma_total = 0;
+        }
+    }
+    uint32_t enabled = ((dma1_channel7.CCR & DMA_CCR_TCIE) ? DMA_ISR_TCIF7 : 0)
+                       | ((dma1_channel7.CCR & DMA_CCR_HTIE) ? DMA_ISR_HTIF7 : 0);
+    if (host_primask == 0 && !in_interrupt && (dma1.ISR & enabled)) {
+        in_interrupt = true;
+        DMA1_Channel7_IRQHandler();
+        in_interrupt = false;
+    }
+}
+
+//send everything queued and hand back the wire
+static size_t drain(void) {
+    USART_tx_flush();
+    size_t length = wire_length;
+    wire_length = 0;
+    return length;
+}
+
+//random writes through every entry point against a copy of what was written
+static bool check_writes(void) {
+    char *expected = malloc(WIRE_SIZE);
+    char *data = malloc(2 * USART_TX_RING_SIZE + 1);
+    size_t expected_length = 0;
+    for (uint32_t n = 0; n < WRITES; n++) {
+        dma_budget = next_random() % 64;
+        uint32_t length = 1 + (next_random() % ((n % 10 == 0) ? 2 * USART_TX_RING_SIZE : 80));
+        for (uint32_t i = 0; i < length; i++) {
+            data[i] = (char)(1 + (next_random() % 255));
+        }
+        data[length] = '\0';
+        //every fourth write comes from an interrupt, which the DMA interrupt cannot preempt
+        host_primask = (n % 4 == 3) ? 1 : 0;
+        switch (next_random() % 3) {
+            case 0: USART_write(data, length); break;
+            case 1: USART_print_string(data); break;
+            default:
+                length = 1;
+                USART_print_char(data[0]);
+        }
+        host_primask = 0;
+        memcpy(expected + expected_length, data, length);
+        expected_length += length;
+    }
+    size_t length = drain();
+    bool same = (length == expected_length) && (memcmp(wire, expected, length) == 0);
+    printf("%-28s %10zu bytes %s\n", "random writes", length, same ? "match" : "DIFFER");
+    free(expected);
+    free(data);
+    return same;
+}
+
+//draw every screen the firmware draws, the start screen painted out first so what follows it
+//does not depend on how far the painting got
+static void draw_screens(void) {
+    Chips chips = starting_chips;
+    USART_start_screen();
+    USART_tx_flush();
+    for (uint32_t i = 0; i < 3 * ARR_SIZE; i++) {
+        USART_print_wheel(wheel_arr, i);
+    }
+    for (uint16_t id = 0; id < NUM_BET_IDS; id++) {
+        USART_print_table(bet_pockets[id]);
+    }
+    USART_print_chips(&chips, 125);
+}
+
+//the same screens with the DMA finishing every transfer at once and crawling along
+static bool check_screens(void) {
+    dma_budget = 0;
+    draw_screens();
+    size_t fast_length = drain();
+    char *fast = malloc(fast_length);
+    memcpy(fast, wire, fast_length);
+    dma_budget = 3;
+    draw_screens();
+    size_t slow_length = drain();
+    bool same = (slow_length == fast_length) && (memcmp(wire, fast, fast_length) == 0);
+    printf("%-28s %10zu bytes %s\n", "screens, fast and slow DMA", slow_length, same ? "match" : "DIFFER");
+    free(fast);
+    return same;
+}
+
+int main(int argc, char **argv) {
+    rng_state = 1;
+    if (argc == 3 && strcmp(argv[1], "-s") == 0) {
+        rng_state = strtoull(argv[2], NULL, 0) | 1;
+    } else if (argc != 1) {
+        fprintf(stderr, "usage: %s [-s seed]\n", argv[0]);
+        return 2;
+    }
+    wire = malloc(WIRE_SIZE);
+    if (wire == NULL) {
+        fprintf(stderr, "usart_check: out of memory\n");
+        return 2;
+    }
+    USART_init();
+    host_primask = 0;
+    bool passed = check_writes();
+    passed = check_screens() && passed;
+    UsartTxStats stats = USART_tx_stats();
+    printf("\n%u queued, %u sent, peak %u of %u, %u transfers, %u full waits, %u errors\n", stats.queued,
+           stats.sent, stats.peak, USART_TX_RING_SIZE, stats.transfers, stats.full_waits, stats.errors);
+    passed = passed && stats.queued == stats.sent && stats.errors == 0 && stats.full_waits > 0;
+    printf("%s\n", passed ? "PASS" : "FAIL");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,316 @@
+//VT100/ANSI terminal emulator for the host check tools
+//
+//rebuilds what a terminal would show from the bytes the firmware sends: printing with deferred
+//wrap and scrolling, cursor moves (CUP, CUU, CUD, CUF, CUB, CHA, VPA), erases (ED, EL, ECH),
+//SGR in the colors and styles of screen.h, DECSC/DECRC, the cursor on and off and the xterm
+//alternate screen. anything else is counted in unknown, so a new code the emulator does not
+//follow fails a check instead of being drawn wrong.
+#include "vt.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ESC '\x1B'
+#define TAB_STOP 8
+#define MAX_NUMBERS 8 //numbers of one sequence read
+
+static const ScreenCell blank_cell = {' ', 0};
+
+static void clear_cells(ScreenCell cells[VT_ROWS][VT_COLS]) {
+    for (uint8_t row = 0; row < VT_ROWS; row++) {
+        for (uint8_t col = 0; col < VT_COLS; col++) {
+            cells[row][col] = blank_cell;
+        }
+    }
+}
+
+//start as after a reset, blank with the cursor at the top left, cols wide
+void vt_init(VtTerminal *vt, uint8_t cols) {
+    memset(vt, 0, sizeof(*vt));
+    vt->cols = (cols > 0 && cols < VT_COLS) ? cols : VT_COLS;
+    clear_cells(vt->cells);
+    clear_cells(vt->main_cells);
+    vt->cursor_visible = true;
+    vt->state = VT_GROUND;
+}
+
+//note a byte or sequence the emulator does not follow, keeping the first for the report
+static void unknown(VtTerminal *vt, const char *what) {
+    if (vt->unknown++ == 0) {
+        snprintf(vt->first_unknown, VT_UNKNOWN_SIZE, "%s", what);
+    }
+}
+
+static void unknown_sequence(VtTerminal *vt, char final) {
+    char text[VT_UNKNOWN_SIZE];
+    snprintf(text, sizeof(text), "ESC [%.*s%c", (int)vt->params_length, vt->params, final);
+    unknown(vt, text);
+}
+
+//move the cursor down a row, scrolling the screen up from the bottom one
+static void line_feed(VtTerminal *vt) {
+    if (vt->cursor.row + 1 < VT_ROWS) {
+        vt->cursor.row++;
+        return;
+    }
+    memmove(vt->cells[0], vt->cells[1], sizeof(vt->cells[0]) * (VT_ROWS - 1));
+    for (uint8_t col = 0; col < VT_COLS; col++) {
+        vt->cells[VT_ROWS - 1][col] = blank_cell;
+    }
+}
+
+static void print(VtTerminal *vt, char ch) {
+    if (vt->cursor.wrap) {
+        vt->cursor.col = 0;
+        vt->cursor.wrap = false;
+        vt->wraps++;
+        line_feed(vt);
+    }
+    vt->cells[vt->cursor.row][vt->cursor.col] = (ScreenCell){ch, vt->cursor.attr};
+    if (vt->cursor.col + 1 < vt->cols) {
+        vt->cursor.col++;
+    } else {
+        vt->cursor.wrap = true;
+    }
+}
+
+static void control(VtTerminal *vt, char ch) {
+    switch (ch) {
+        case '\r': vt->cursor.col = 0; break;
+        case '\n': line_feed(vt); break;
+        case '\b': vt->cursor.col -= (vt->cursor.col > 0) ? 1 : 0; break;
+        case '\t': vt->cursor.col = (vt->cursor.col / TAB_STOP + 1) * TAB_STOP; break;
+        case '\a': return;
+        default: {
+            char text[8];
+            snprintf(text, sizeof(text), "0x%02X", (unsigned char)ch);
+            unknown(vt, text);
+            return;
+        }
+    }
+    vt->cursor.col = (vt->cursor.col < vt->cols) ? vt->cursor.col : vt->cols - 1;
+    vt->cursor.wrap = false;
+}
+
+//numbers of the sequence separated by ';', missing ones 0, returns how many
+static uint8_t read_numbers(const VtTerminal *vt, uint8_t first, uint32_t *numbers) {
+    uint8_t count = 0;
+    numbers[0] = 0;
+    for (uint8_t i = first; i < vt->params_length; i++) {
+        char ch = vt->params[i];
+        if (ch == ';' && count + 1 == MAX_NUMBERS) {
+            break;
+        } else if (ch == ';') {
+            numbers[++count] = 0;
+        } else if (ch >= '0' && ch <= '9') {
+            numbers[count] = (numbers[count] * 10) + (uint32_t)(ch - '0');
+        }
+    }
+    return count + 1;
+}
+
+//a count or position parameter, where 0 and missing both mean 1
+static uint32_t at_least_one(uint32_t value) {
+    return (value == 0) ? 1 : value;
+}
+
+static void erase(VtTerminal *vt, uint8_t row, uint8_t from, uint8_t to) {
+    for (uint8_t col = from; col < to && col < vt->cols; col++) {
+        vt->cells[row][col] = blank_cell;
+    }
+}
+
+//foreground color of an SGR parameter, a sub parameter list like "38:5:202" whole
+static bool sgr_color(const char *param, uint8_t *attr) {
+    static const struct {
+        const char *param;
+        uint8_t color;
+    } colors[] = {{"30", COLOR_BLACK}, {"31", COLOR_RED}, {"32", COLOR_GREEN}, {"33", COLOR_YELLOW},
+                  {"34", COLOR_BLUE}, {"35", COLOR_PURPLE}, {"38:5:202", COLOR_ORANGE}, {"96", COLOR_CYAN},
+                  {"39", COLOR_DEFAULT}};
+    for (uint8_t i = 0; i < sizeof(colors) / sizeof(colors[0]); i++) {
+        if (strcmp(param, colors[i].param) == 0) {
+            *attr = (uint8_t)((*attr & ~ATTR_COLOR) | colors[i].color);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void select_rendition(VtTerminal *vt) {
+    char params[VT_PARAMS_SIZE + 1];
+    memcpy(params, vt->params, vt->params_length);
+    params[vt->params_length] = '\0';
+    uint8_t attr = vt->cursor.attr;
+    char *param = params;
+    while (param != NULL) {
+        char *next = strchr(param, ';');
+        if (next != NULL) {
+            *next++ = '\0';
+        }
+        if (param[0] == '\0' || strcmp(param, "0") == 0) {
+            attr = 0;
+        } else if (strcmp(param, "1") == 0) {
+            attr |= ATTR_BOLD;
+        } else if (strcmp(param, "22") == 0) {
+            attr &= ~ATTR_BOLD;
+        } else if (strcmp(param, "4") == 0) {
+            attr |= ATTR_UNDERLINE;
+        } else if (strcmp(param, "24") == 0) {
+            attr &= ~ATTR_UNDERLINE;
+        } else if (!sgr_color(param, &attr)) {
+            unknown_sequence(vt, 'm');
+        }
+        param = next;
+    }
+    vt->cursor.attr = attr;
+}
+
+//DEC private modes, ESC [ ? n h and l
+static void private_mode(VtTerminal *vt, char final) {
+    uint32_t numbers[MAX_NUMBERS];
+    read_numbers(vt, 1, numbers);
+    bool set = (final == 'h');
+    switch (numbers[0]) {
+        case 7: //autowrap, the game never turns it off
+            if (!set) {
+                unknown_sequence(vt, final);
+            }
+            break;
+        case 25:
+            vt->cursor_visible = set;
+            break;
+        case 1049: //alternate screen, entered blank with the cursor of the game screen kept
+            if (set && !vt->alternate) {
+                memcpy(vt->main_cells, vt->cells, sizeof(vt->cells));
+                vt->main_cursor = vt->cursor;
+                clear_cells(vt->cells);
+            } else if (!set && vt->alternate) {
+                memcpy(vt->cells, vt->main_cells, sizeof(vt->cells));
+                vt->cursor = vt->main_cursor;
+            }
+            vt->alternate = set;
+            break;
+        default:
+            unknown_sequence(vt, final);
+    }
+}
+
+static void control_sequence(VtTerminal *vt, char final) {
+    if (vt->params_length > 0 && vt->params[0] == '?') {
+        if (final == 'h' || final == 'l') {
+            private_mode(vt, final);
+        } else {
+            unknown_sequence(vt, final);
+        }
+        return;
+    }
+    if (final == 'm') {
+        select_rendition(vt);
+        return;
+    }
+    uint32_t numbers[MAX_NUMBERS];
+    uint8_t count = read_numbers(vt, 0, numbers);
+    uint32_t n = at_least_one(numbers[0]);
+    VtCursor *cursor = &vt->cursor;
+    switch (final) {
+        case 'H':
+        case 'f':
+            cursor->row = (uint8_t)(((n < VT_ROWS) ? n : VT_ROWS) - 1);
+            n = (count > 1) ? at_least_one(numbers[1]) : 1;
+            cursor->col = (uint8_t)(((n < vt->cols) ? n : vt->cols) - 1);
+            break;
+        case 'A': cursor->row = (uint8_t)((cursor->row > n) ? cursor->row - n : 0); break;
+        case 'B': cursor->row = (uint8_t)((cursor->row + n < VT_ROWS) ? cursor->row + n : VT_ROWS - 1); break;
+        case 'C': cursor->col = (uint8_t)((cursor->col + n < vt->cols) ? cursor->col + n : vt->cols - 1u); break;
+        case 'D': cursor->col = (uint8_t)((cursor->col > n) ? cursor->col - n : 0); break;
+        case 'G': cursor->col = (uint8_t)(((n < vt->cols) ? n : vt->cols) - 1); break;
+        case 'd': cursor->row = (uint8_t)(((n < VT_ROWS) ? n : VT_ROWS) - 1); break;
+        case 'J':
+            if (numbers[0] > 2) {
+                unknown_sequence(vt, final);
+                return;
+            }
+            for (uint8_t row = 0; row < VT_ROWS; row++) {
+                if (numbers[0] == 2 || (numbers[0] == 0 && row > cursor->row) || (numbers[0] == 1 && row < cursor->row)) {
+                    erase(vt, row, 0, vt->cols);
+                }
+            }
+            if (numbers[0] != 2) {
+                erase(vt, cursor->row, (numbers[0] == 0) ? cursor->col : 0,
+                      (numbers[0] == 1) ? cursor->col + 1 : vt->cols);
+            }
+            break;
+        case 'K':
+            if (numbers[0] > 2) {
+                unknown_sequence(vt, final);
+                return;
+            }
+            erase(vt, cursor->row, (numbers[0] == 0) ? cursor->col : 0,
+                  (numbers[0] == 1) ? cursor->col + 1 : vt->cols);
+            break;
+        case 'X':
+            erase(vt, cursor->row, cursor->col, (uint8_t)((cursor->col + n < vt->cols) ? cursor->col + n : vt->cols));
+            return; //leaves a pending wrap alone
+        default:
+            unknown_sequence(vt, final);
+            return;
+    }
+    cursor->wrap = false;
+}
+
+static void escape(VtTerminal *vt, char ch) {
+    switch (ch) {
+        case '[':
+            vt->state = VT_CSI;
+            vt->params_length = 0;
+            return;
+        case '7':
+            vt->saved = vt->cursor;
+            break;
+        case '8':
+            vt->cursor = vt->saved;
+            break;
+        case 'c':
+            vt_init(vt, vt->cols);
+            break;
+        default: {
+            char text[8];
+            snprintf(text, sizeof(text), "ESC %c", ch);
+            unknown(vt, text);
+        }
+    }
+    vt->state = VT_GROUND;
+}
+
+//what the terminal does with bytes from the wire
+void vt_feed(VtTerminal *vt, const char *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        char ch = data[i];
+        vt->bytes++;
+        switch (vt->state) {
+            case VT_GROUND:
+                if (ch == ESC) {
+                    vt->state = VT_ESCAPE;
+                } else if ((unsigned char)ch < 0x20 || ch == 0x7F) {
+                    control(vt, ch);
+                } else {
+                    print(vt, ch);
+                }
+                break;
+            case VT_ESCAPE:
+                escape(vt, ch);
+                break;
+            case VT_CSI:
+                if (ch >= 0x40 && ch <= 0x7E) {
+                    control_sequence(vt, ch);
+                    vt->state = VT_GROUND;
+                } else if (ch >= 0x20 && ch < 0x40 && vt->params_length < VT_PARAMS_SIZE) {
+                    vt->params[vt->params_length++] = ch;
+                } else {
+                    unknown(vt, "broken ESC [");
+                    vt->state = (ch == ESC) ? VT_ESCAPE : VT_GROUND;
+                }
+                break;
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef TOOLS_VT_H_
+#define TOOLS_VT_H_
+#include "screen.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+#define VT_ROWS 40 //terminal the game is checked on, larger than the game so a stray move shows
+#define VT_COLS 80 //most columns, vt_init() may set a narrower terminal
+#define VT_PARAMS_SIZE 32 //parameter bytes of one control sequence kept
+#define VT_UNKNOWN_SIZE 24 //bytes of the first unknown sequence kept for the report
+
+//parser states
+typedef enum {
+    VT_GROUND, //printing
+    VT_ESCAPE, //after ESC
+    VT_CSI //inside ESC [
+} VtState;
+
+//cursor and what DECSC saves with it
+typedef struct {
+    uint8_t row; //0 based
+    uint8_t col;
+    uint8_t attr; //ScreenCell attributes the next character is printed in
+    bool wrap; //a character went into the last column, the next one wraps first
+} VtCursor;
+
+//VT100/ANSI terminal, enough of xterm for every code the game sends. the cells use the attributes
+//of screen.h so a terminal can be compared with a Screen, and anything it does not know is
+//counted rather than guessed at
+typedef struct {
+    uint8_t cols; //columns of the terminal, up to VT_COLS, the cells right of them stay blank
+    ScreenCell cells[VT_ROWS][VT_COLS]; //screen shown
+    ScreenCell main_cells[VT_ROWS][VT_COLS]; //game screen while the alternate one is up
+    VtCursor cursor;
+    VtCursor saved; //DECSC
+    VtCursor main_cursor; //cursor of the game screen while the alternate one is up
+    bool alternate;
+    bool cursor_visible;
+    VtState state;
+    char params[VT_PARAMS_SIZE]; //parameter and intermediate bytes of the sequence being read
+    uint8_t params_length;
+    uint32_t bytes; //bytes fed
+    uint32_t wraps; //lines printed past the last column onto the next row
+    uint32_t unknown; //sequences and control characters ignored
+    char first_unknown[VT_UNKNOWN_SIZE]; //the first of them, printable
+} VtTerminal;
+
+void vt_init(VtTerminal *, uint8_t);
+void vt_feed(VtTerminal *, const char *, size_t);
+
+#endif